@@ -0,0 +1,644 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_SPRITES = 200;
+const int DOT_CLIPS = 4;
+const int WALKING_ANIMATION_FRAMES = 4;
+const SDL_Color WHITE = { 0xFF, 0xFF, 0xFF, 0xFF };
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Draw layers, lower layers are submitted first
+enum RenderLayer {
+    LAYER_BACKGROUND,
+    LAYER_SPRITES,
+    LAYER_OVERLAY,
+    LAYER_TOTAL
+};
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set color modulation
+        void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //set alpha modulation
+        void setAlpha( Uint8 alpha );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+        //Gets hardware texture and blending for queued rendering
+        SDL_Texture* getTexture();
+        SDL_BlendMode getBlendMode();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Current blending
+        SDL_BlendMode mBlendMode;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mBlendMode = SDL_BLENDMODE_BLEND;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+            SDL_GetTextureBlendMode(newTexture, &mBlendMode);
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue ) {
+    //Modulate Texture
+    SDL_SetTextureColorMod( mTexture, red, green, blue );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    //Set blending function
+    mBlendMode = blending;
+    SDL_SetTextureBlendMode( mTexture, blending );
+}
+
+void LTexture::setAlpha( Uint8 alpha ) {
+    SDL_SetTextureAlphaMod( mTexture, alpha );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+SDL_Texture* LTexture::getTexture() {
+    return mTexture;
+}
+
+SDL_BlendMode LTexture::getBlendMode() {
+    return mBlendMode;
+}
+
+//A single recorded draw
+struct LRenderCommand {
+    //Texture and its slot in the queue's state table
+    SDL_Texture* texture;
+    Uint16 textureId;
+
+    //Source and destination rectangles
+    SDL_Rect clip;
+    SDL_Rect quad;
+    bool hasClip;
+
+    //Modulation and blending to draw with
+    SDL_Color color;
+    SDL_BlendMode blendMode;
+};
+
+//State changes counted during the last flush
+struct LRenderStats {
+    //Draws submitted
+    int commands;
+
+    //State changes issued in sorted order
+    int stateChanges;
+
+    //State changes submission order would have needed
+    int unsortedStateChanges;
+
+    //Difference between the two
+    int avoided;
+};
+
+//Records draws and submits them sorted by a 64-bit key
+class LRenderQueue {
+    public:
+        //Initializes internal variables
+        LRenderQueue();
+
+        //Marks a translucent layer whose draws must stay in depth order
+        void setLayerOrdered( Uint8 layer, bool ordered );
+
+        //Records a draw of texture at a given point
+        void push( LTexture* texture, int x, int y, SDL_Rect* clip, Uint8 layer, Uint32 depth, SDL_Color color = WHITE );
+
+        //Sorts and submits recorded draws, then empties the queue
+        void flush();
+
+        //Enables or disables sorting before submission
+        void setSorting( bool sorting );
+        bool getSorting();
+
+        //Gets counters from the last flush
+        LRenderStats getStats();
+
+    private:
+        //Per texture state as last set on the renderer
+        struct TextureState {
+            SDL_Color color;
+            SDL_BlendMode blendMode;
+            bool valid;
+        };
+
+        //Maps a texture to a small id for the sort key
+        Uint16 getTextureId( SDL_Texture* texture );
+
+        //Stable LSD radix sort of keys, carrying draw indices along
+        void sortKeys();
+
+        //Walks draws in mOrder counting state changes, optionally rendering them
+        int walk( bool submit );
+
+        std::vector<LRenderCommand> mCommands;
+        std::vector<Uint64> mKeys;
+        std::vector<Uint64> mKeysScratch;
+        std::vector<Uint32> mOrder;
+        std::vector<Uint32> mOrderScratch;
+
+        //Known textures and their renderer state
+        std::vector<SDL_Texture*> mTextures;
+        std::vector<TextureState> mTextureStates;
+
+        bool mOrderedLayers[ 256 ];
+        bool mSorting;
+        LRenderStats mStats;
+};
+
+//Sort key layouts, most significant field first
+//Opaque layers:  layer:8 | blend:4 | texture:16 | depth:24 | unused:12
+//Ordered layers: layer:8 | depth:24 | blend:4 | texture:16 | unused:12
+//Equal keys keep submission order since the sort is stable
+const Uint64 KEY_DEPTH_MASK = 0xFFFFFF;
+
+Uint64 blendKey( SDL_BlendMode blending ) {
+    switch( blending ) {
+        case SDL_BLENDMODE_NONE: return 0;
+        case SDL_BLENDMODE_BLEND: return 1;
+        case SDL_BLENDMODE_ADD: return 2;
+        case SDL_BLENDMODE_MOD: return 3;
+        default: return 4;
+    }
+}
+
+LRenderQueue::LRenderQueue() {
+    for (int i = 0; i < 256; i++)
+        mOrderedLayers[i] = false;
+    mSorting = true;
+    mStats.commands = 0;
+    mStats.stateChanges = 0;
+    mStats.unsortedStateChanges = 0;
+    mStats.avoided = 0;
+}
+
+void LRenderQueue::setLayerOrdered( Uint8 layer, bool ordered ) {
+    mOrderedLayers[layer] = ordered;
+}
+
+void LRenderQueue::setSorting( bool sorting ) {
+    mSorting = sorting;
+}
+
+bool LRenderQueue::getSorting() {
+    return mSorting;
+}
+
+LRenderStats LRenderQueue::getStats() {
+    return mStats;
+}
+
+Uint16 LRenderQueue::getTextureId( SDL_Texture* texture ) {
+    for (size_t i = 0; i < mTextures.size(); i++) {
+        if (mTextures[i] == texture)
+            return (Uint16) i;
+    }
+
+    //First time we see this texture
+    TextureState state;
+    state.valid = false;
+    mTextures.push_back( texture );
+    mTextureStates.push_back( state );
+    return (Uint16) (mTextures.size() - 1);
+}
+
+void LRenderQueue::push( LTexture* texture, int x, int y, SDL_Rect* clip, Uint8 layer, Uint32 depth, SDL_Color color ) {
+    LRenderCommand command;
+    command.texture = texture->getTexture();
+    command.textureId = getTextureId( command.texture );
+    command.quad.x = x;
+    command.quad.y = y;
+    command.quad.w = texture->getWidth();
+    command.quad.h = texture->getHeight();
+    command.hasClip = clip != NULL;
+    if (clip != NULL) {
+        command.clip = *clip;
+        command.quad.w = clip->w;
+        command.quad.h = clip->h;
+    }
+    command.color = color;
+    command.blendMode = texture->getBlendMode();
+
+    //Build sort key
+    Uint64 key = (Uint64) layer << 56;
+    Uint64 blend = blendKey( command.blendMode );
+    Uint64 id = command.textureId;
+    Uint64 z = depth & KEY_DEPTH_MASK;
+    if (mOrderedLayers[layer])
+        key |= ( z << 32 ) | ( blend << 28 ) | ( id << 12 );
+    else
+        key |= ( blend << 52 ) | ( id << 36 ) | ( z << 12 );
+
+    mCommands.push_back( command );
+    mKeys.push_back( key );
+}
+
+void LRenderQueue::sortKeys() {
+    size_t count = mKeys.size();
+    if (count < 2)
+        return;
+
+    mKeysScratch.resize( count );
+    mOrderScratch.resize( count );
+    for (int shift = 0; shift < 64; shift += 8) {
+        //Histogram of this byte
+        Uint32 offsets[256] = { 0 };
+        for (size_t i = 0; i < count; i++)
+            offsets[ ( mKeys[i] >> shift ) & 0xFF ]++;
+
+        //Every key shares this byte so the pass would not move anything
+        if (offsets[ ( mKeys[0] >> shift ) & 0xFF ] == count)
+            continue;
+
+        //Turn counts into starting offsets
+        Uint32 total = 0;
+        for (int b = 0; b < 256; b++) {
+            Uint32 bucket = offsets[b];
+            offsets[b] = total;
+            total += bucket;
+        }
+
+        //Scatter keeping relative order of equal bytes
+        for (size_t i = 0; i < count; i++) {
+            Uint32 slot = offsets[ ( mKeys[i] >> shift ) & 0xFF ]++;
+            mKeysScratch[slot] = mKeys[i];
+            mOrderScratch[slot] = mOrder[i];
+        }
+        mKeys.swap( mKeysScratch );
+        mOrder.swap( mOrderScratch );
+    }
+}
+
+int LRenderQueue::walk( bool submit ) {
+    int changes = 0;
+    SDL_Texture* currentTexture = NULL;
+    SDL_BlendMode currentBlend = SDL_BLENDMODE_INVALID;
+    SDL_Color currentColor = WHITE;
+    bool first = true;
+
+    for (size_t i = 0; i < mOrder.size(); i++) {
+        LRenderCommand& command = mCommands[ mOrder[i] ];
+        const SDL_Color& c = command.color;
+
+        //Count transitions a batching backend would have to break on
+        if (first || command.texture != currentTexture)
+            changes++;
+        if (first || command.blendMode != currentBlend)
+            changes++;
+        if (first || c.r != currentColor.r || c.g != currentColor.g || c.b != currentColor.b || c.a != currentColor.a)
+            changes++;
+        currentTexture = command.texture;
+        currentBlend = command.blendMode;
+        currentColor = c;
+        first = false;
+
+        if (submit) {
+            //Only touch texture state that differs from what we last set
+            TextureState& state = mTextureStates[ command.textureId ];
+            if (!state.valid || state.blendMode != command.blendMode) {
+                SDL_SetTextureBlendMode( command.texture, command.blendMode );
+                state.blendMode = command.blendMode;
+            }
+            if (!state.valid || state.color.r != c.r || state.color.g != c.g || state.color.b != c.b)
+                SDL_SetTextureColorMod( command.texture, c.r, c.g, c.b );
+            if (!state.valid || state.color.a != c.a)
+                SDL_SetTextureAlphaMod( command.texture, c.a );
+            state.color = c;
+            state.valid = true;
+
+            SDL_RenderCopy( gRenderer, command.texture, command.hasClip ? &command.clip : NULL, &command.quad );
+        }
+    }
+    return changes;
+}
+
+void LRenderQueue::flush() {
+    //Identity order is what immediate rendering would have done
+    mOrder.resize( mCommands.size() );
+    for (size_t i = 0; i < mOrder.size(); i++)
+        mOrder[i] = (Uint32) i;
+    mStats.commands = (int) mCommands.size();
+    mStats.unsortedStateChanges = walk( false );
+
+    if (mSorting)
+        sortKeys();
+
+    //Renderer state may have been touched outside the queue since last frame
+    for (size_t i = 0; i < mTextureStates.size(); i++)
+        mTextureStates[i].valid = false;
+
+    mStats.stateChanges = walk( true );
+    mStats.avoided = mStats.unsortedStateChanges - mStats.stateChanges;
+
+    //Keep capacity for next frame
+    mCommands.clear();
+    mKeys.clear();
+}
+
+//A moving sprite in the scene
+struct LSprite {
+    int x, y;
+    int speed;
+    bool isDot;
+    int clip;
+    SDL_Color color;
+};
+
+LTexture gBackgroundTexture;
+LTexture gDotsTexture;
+LTexture gFooTexture;
+LTexture gOverlayTexture;
+SDL_Rect gDotClips[ DOT_CLIPS ];
+SDL_Rect gFooClips[ WALKING_ANIMATION_FRAMES ];
+LSprite gSprites[ TOTAL_SPRITES ];
+LRenderQueue gRenderQueue;
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gBackgroundTexture.loadFromFile("background.png")) {
+        printf("Failed to load background texture!\n");
+        success = false;
+    }
+
+    if (!gDotsTexture.loadFromFile("dots.png")) {
+        printf("Failed to load dots texture!\n");
+        success = false;
+    }
+
+    if (!gFooTexture.loadFromFile("foo.png")) {
+        printf("Failed to load foo texture!\n");
+        success = false;
+    }
+
+    if (!gOverlayTexture.loadFromFile("fadeout.png")) {
+        printf("Failed to load overlay texture!\n");
+        success = false;
+    }
+    else {
+        gOverlayTexture.setBlendMode( SDL_BLENDMODE_BLEND );
+    }
+
+    return success;
+}
+
+void initSpriteClips() {
+    for (int i = 0; i < DOT_CLIPS; i++) {
+        gDotClips[i].x = ( i % 2 ) * 100;
+        gDotClips[i].y = ( i / 2 ) * 100;
+        gDotClips[i].w = 100;
+        gDotClips[i].h = 100;
+    }
+
+    for (int i = 0; i < WALKING_ANIMATION_FRAMES; i++) {
+        gFooClips[i].x = i * 64;
+        gFooClips[i].y = 0;
+        gFooClips[i].w = 64;
+        gFooClips[i].h = 205;
+    }
+}
+
+void initSprites() {
+    //Fixed seed so every run draws the same scene
+    srand( 42 );
+    for (int i = 0; i < TOTAL_SPRITES; i++) {
+        //Alternate textures so submission order thrashes binds
+        gSprites[i].isDot = i % 2 == 0;
+        gSprites[i].x = rand() % SCREEN_WIDTH;
+        gSprites[i].y = rand() % SCREEN_HEIGHT - 100;
+        gSprites[i].speed = 1 + rand() % 3;
+        gSprites[i].clip = rand() % DOT_CLIPS;
+        gSprites[i].color = WHITE;
+
+        //Tint a third of the dots
+        if (gSprites[i].isDot && i % 3 == 0) {
+            gSprites[i].color.g = 0x80;
+            gSprites[i].color.b = 0x80;
+        }
+    }
+}
+
+void close() {
+    gBackgroundTexture.free();
+    gDotsTexture.free();
+    gFooTexture.free();
+    gOverlayTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        //Let SDL merge consecutive copies that share state
+        SDL_SetHint( SDL_HINT_RENDER_BATCHING, "1" );
+
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            initSpriteClips();
+            initSprites();
+
+            //The overlay is translucent so its draws must keep their order
+            gRenderQueue.setLayerOrdered( LAYER_OVERLAY, true );
+
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Space toggles sorting to compare against submission order
+                    else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE ) {
+                        gRenderQueue.setSorting( !gRenderQueue.getSorting() );
+                        printf("Sorting %s\n", gRenderQueue.getSorting() ? "enabled" : "disabled");
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Record the scene in the order game code reaches it
+                gRenderQueue.push( &gBackgroundTexture, 0, 0, NULL, LAYER_BACKGROUND, 0 );
+                for (int i = 0; i < TOTAL_SPRITES; i++) {
+                    LSprite& sprite = gSprites[i];
+                    sprite.x = ( sprite.x + sprite.speed ) % SCREEN_WIDTH;
+                    if (sprite.isDot)
+                        gRenderQueue.push( &gDotsTexture, sprite.x, sprite.y, &gDotClips[ sprite.clip ], LAYER_SPRITES, i, sprite.color );
+                    else
+                        gRenderQueue.push( &gFooTexture, sprite.x, sprite.y, &gFooClips[ ( frame / 8 ) % WALKING_ANIMATION_FRAMES ], LAYER_SPRITES, i );
+                }
+                SDL_Color veil = { 0xFF, 0xFF, 0xFF, 0x40 };
+                gRenderQueue.push( &gOverlayTexture, 0, 0, NULL, LAYER_OVERLAY, 0, veil );
+
+                //Sort and draw
+                gRenderQueue.flush();
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                //Report state changes once a second
+                LRenderStats stats = gRenderQueue.getStats();
+                if (frame % 60 == 0)
+                    printf("Frame %d: %d draws, %d state changes, %d avoided (%d in submission order)\n", frame, stats.commands, stats.stateChanges, stats.avoided, stats.unsortedStateChanges);
+                ++frame;
+            }
+        }
+    }
+    close();
+    return 0;
+}
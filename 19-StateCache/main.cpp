@@ -0,0 +1,514 @@
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//SDL state calls issued and skipped
+struct LStateCounters {
+    int issued;
+    int elided;
+};
+
+//Caches renderer state and skips calls that would not change it
+class LRenderState {
+    public:
+        //Initializes internal variables
+        LRenderState();
+
+        //Forgets cached values, use after touching gRenderer directly
+        void invalidate();
+
+        //Set draw color
+        void setDrawColor( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha );
+
+        //Set blending for draw calls
+        void setDrawBlendMode( SDL_BlendMode blending );
+
+        //Set viewport, NULL for the whole target
+        void setViewport( SDL_Rect* viewport );
+
+        //Set render target, NULL for the window
+        void setTarget( SDL_Texture* target );
+
+        //Records a call made or skipped by a texture level cache
+        void count( bool issued );
+
+        //Closes the current frame's counters
+        void endFrame();
+
+        //Gets counters for the last finished frame
+        LStateCounters getFrameCounters();
+
+    private:
+        //Draw color
+        Uint8 mDrawColor[4];
+        bool mDrawColorValid;
+
+        //Draw blending
+        SDL_BlendMode mDrawBlendMode;
+        bool mDrawBlendModeValid;
+
+        //Viewport, full target when mFullViewport is set
+        SDL_Rect mViewport;
+        bool mFullViewport;
+        bool mViewportValid;
+
+        //Render target
+        SDL_Texture* mTarget;
+        bool mTargetValid;
+
+        //Counters for the frame in progress and the last one
+        LStateCounters mCurrent;
+        LStateCounters mLastFrame;
+};
+
+LRenderState::LRenderState() {
+    invalidate();
+    mCurrent.issued = 0;
+    mCurrent.elided = 0;
+    mLastFrame = mCurrent;
+}
+
+void LRenderState::invalidate() {
+    mDrawColorValid = false;
+    mDrawBlendModeValid = false;
+    mViewportValid = false;
+    mTargetValid = false;
+}
+
+void LRenderState::count( bool issued ) {
+    if (issued)
+        mCurrent.issued++;
+    else
+        mCurrent.elided++;
+}
+
+void LRenderState::setDrawColor( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha ) {
+    if (mDrawColorValid && mDrawColor[0] == red && mDrawColor[1] == green && mDrawColor[2] == blue && mDrawColor[3] == alpha) {
+        count( false );
+        return;
+    }
+    SDL_SetRenderDrawColor( gRenderer, red, green, blue, alpha );
+    mDrawColor[0] = red;
+    mDrawColor[1] = green;
+    mDrawColor[2] = blue;
+    mDrawColor[3] = alpha;
+    mDrawColorValid = true;
+    count( true );
+}
+
+void LRenderState::setDrawBlendMode( SDL_BlendMode blending ) {
+    if (mDrawBlendModeValid && mDrawBlendMode == blending) {
+        count( false );
+        return;
+    }
+    SDL_SetRenderDrawBlendMode( gRenderer, blending );
+    mDrawBlendMode = blending;
+    mDrawBlendModeValid = true;
+    count( true );
+}
+
+void LRenderState::setViewport( SDL_Rect* viewport ) {
+    if (mViewportValid) {
+        bool same;
+        if (viewport == NULL)
+            same = mFullViewport;
+        else
+            same = !mFullViewport && mViewport.x == viewport->x && mViewport.y == viewport->y && mViewport.w == viewport->w && mViewport.h == viewport->h;
+        if (same) {
+            count( false );
+            return;
+        }
+    }
+    SDL_RenderSetViewport( gRenderer, viewport );
+    mFullViewport = viewport == NULL;
+    if (viewport != NULL)
+        mViewport = *viewport;
+    mViewportValid = true;
+    count( true );
+}
+
+void LRenderState::setTarget( SDL_Texture* target ) {
+    if (mTargetValid && mTarget == target) {
+        count( false );
+        return;
+    }
+    SDL_SetRenderTarget( gRenderer, target );
+    mTarget = target;
+    mTargetValid = true;
+
+    //Switching targets resets the viewport to the whole target
+    mFullViewport = true;
+    mViewportValid = true;
+    count( true );
+}
+
+void LRenderState::endFrame() {
+    mLastFrame = mCurrent;
+    mCurrent.issued = 0;
+    mCurrent.elided = 0;
+}
+
+LStateCounters LRenderState::getFrameCounters() {
+    return mLastFrame;
+}
+
+LRenderState gRenderState;
+
+//Wrapper class for texture
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set color modulation
+        void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //set alpha modulation
+        void setAlpha( Uint8 alpha );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Modulation and blending last set on mTexture
+        Uint8 mRed;
+        Uint8 mGreen;
+        Uint8 mBlue;
+        Uint8 mAlpha;
+        SDL_BlendMode mBlendMode;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mRed = 0xFF;
+    mGreen = 0xFF;
+    mBlue = 0xFF;
+    mAlpha = 0xFF;
+    mBlendMode = SDL_BLENDMODE_NONE;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+
+            //New textures start unmodulated
+            mRed = 0xFF;
+            mGreen = 0xFF;
+            mBlue = 0xFF;
+            mAlpha = 0xFF;
+            SDL_GetTextureBlendMode( newTexture, &mBlendMode );
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mRed = 0xFF;
+        mGreen = 0xFF;
+        mBlue = 0xFF;
+        mAlpha = 0xFF;
+        mBlendMode = SDL_BLENDMODE_NONE;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue ) {
+    //Skip if texture is already modulated this way
+    if (red == mRed && green == mGreen && blue == mBlue) {
+        gRenderState.count( false );
+        return;
+    }
+
+    //Modulate Texture
+    SDL_SetTextureColorMod( mTexture, red, green, blue );
+    mRed = red;
+    mGreen = green;
+    mBlue = blue;
+    gRenderState.count( true );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    if (blending == mBlendMode) {
+        gRenderState.count( false );
+        return;
+    }
+
+    //Set blending function
+    SDL_SetTextureBlendMode( mTexture, blending );
+    mBlendMode = blending;
+    gRenderState.count( true );
+}
+
+void LTexture::setAlpha( Uint8 alpha ) {
+    if (alpha == mAlpha) {
+        gRenderState.count( false );
+        return;
+    }
+
+    SDL_SetTextureAlphaMod( mTexture, alpha );
+    mAlpha = alpha;
+    gRenderState.count( true );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gModTexture;
+LTexture gFadeTexture;
+SDL_Rect gPreviewViewport;
+
+bool loadMedia() {
+    bool success = true;
+    //Load color texture
+    if ( !gModTexture.loadFromFile("colors.png") ) {
+        printf("Failed to load colors texture!\n");
+        success = false;
+    }
+
+    //Load front alpha texture
+    if ( !gFadeTexture.loadFromFile("fadeout.png") ) {
+        printf("Failed to load fade texture!\n");
+        success = false;
+    }
+    return success;
+}
+
+void close() {
+    gModTexture.free();
+    gFadeTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                gRenderState.setDrawColor( 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            Uint8 r = 255;
+            Uint8 g = 255;
+            Uint8 b = 255;
+            Uint8 a = 255;
+            int frame = 0;
+
+            //Small preview in the top right corner
+            gPreviewViewport.x = SCREEN_WIDTH * 3 / 4;
+            gPreviewViewport.y = 0;
+            gPreviewViewport.w = SCREEN_WIDTH / 4;
+            gPreviewViewport.h = SCREEN_HEIGHT / 4;
+
+            gFadeTexture.setBlendMode( SDL_BLENDMODE_BLEND );
+
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //SDL_Quit event is pressing X
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch(e.key.keysym.sym) {
+                            //Increase red
+                            case SDLK_q:
+                            r += 32;
+                            break;
+
+                            //Increase green
+                            case SDLK_w:
+                            g += 32;
+                            break;
+
+                            //Increase blue
+                            case SDLK_e:
+                            b += 32;
+                            break;
+
+                            //Decrease red
+                            case SDLK_a:
+                            r -= 32;
+                            break;
+
+                            //Decrease green
+                            case SDLK_s:
+                            g -= 32;
+                            break;
+
+                            //Decrease blue
+                            case SDLK_d:
+                            b -= 32;
+                            break;
+
+                            //Increase alpha
+                            case SDLK_UP:
+                            if (a + 32 > 255) a = 255;
+                            else a += 32;
+                            break;
+
+                            //Decrease alpha
+                            case SDLK_DOWN:
+                            if (a - 32 < 0) a = 0;
+                            else a -= 32;
+                            break;
+                        }
+                    }
+                }
+                //Initialize renderer color
+                gRenderState.setDrawColor( 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                gRenderState.setViewport( NULL );
+                SDL_RenderClear( gRenderer );
+
+                //Modulate and render texture
+                gModTexture.setColor( r, g, b );
+                gModTexture.render( 0, 0 );
+
+                //Blend faded texture on top
+                gFadeTexture.setAlpha( a );
+                gFadeTexture.render( 0, 0 );
+
+                //Corner of the modulated texture in its own viewport
+                gRenderState.setViewport( &gPreviewViewport );
+                gModTexture.render( 0, 0 );
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                //Report calls issued against calls skipped once a second
+                gRenderState.endFrame();
+                LStateCounters counters = gRenderState.getFrameCounters();
+                if (frame % 60 == 0)
+                    printf("Frame %d: %d state calls issued, %d elided\n", frame, counters.issued, counters.elided);
+                ++frame;
+            }
+        }
+    }
+    close();
+    return 0;
+}
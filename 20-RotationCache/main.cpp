@@ -0,0 +1,479 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <cmath>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int ROTATION_STEPS = 6;
+const int BENCH_SPRITES = 200;
+const int BENCH_FRAMES = 120;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Creates blank texture
+        bool createBlank( int width, int height, SDL_TextureAccess access );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set self as render target
+        void setAsRenderTarget();
+
+        //Set color modulation
+        void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //set alpha modulation
+        void setAlpha( Uint8 alpha );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+bool LTexture::createBlank( int width, int height, SDL_TextureAccess access ) {
+    //Delete the previous texture
+    free();
+
+    //Create uninitialized texture
+    mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, access, width, height );
+    if (mTexture == NULL)
+        printf("Unable to create blank texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        mWidth = width;
+        mHeight = height;
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::setAsRenderTarget() {
+    //Make self render target
+    SDL_SetRenderTarget( gRenderer, mTexture );
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue ) {
+    //Modulate Texture
+    SDL_SetTextureColorMod( mTexture, red, green, blue );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    //Set blending function
+    SDL_SetTextureBlendMode( mTexture, blending );
+}
+
+void LTexture::setAlpha( Uint8 alpha ) {
+    SDL_SetTextureAlphaMod( mTexture, alpha );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+//Flip modes kept in the cache, one atlas row each
+const int CACHED_FLIPS = 3;
+const SDL_RendererFlip gCachedFlips[ CACHED_FLIPS ] = { SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL };
+
+//Atlas of a sprite pre-rendered at quantized angles and flips
+class LRotationCache {
+    public:
+        //Initializes internal variables
+        LRotationCache();
+
+        //Renders every orientation of source into the atlas
+        bool build( LTexture* source, int steps );
+
+        //Deallocates atlas
+        void free();
+
+        //Renders source rotated about its center, from the atlas when possible
+        void render( int x, int y, double angle, SDL_RendererFlip flip );
+
+        //Enables or disables atlas lookups
+        void setEnabled( bool enabled );
+
+        //Gets lookups served by the atlas and by true rotation
+        int getHits();
+        int getMisses();
+
+    private:
+        //Finds the atlas cell for an orientation, -1 if not cached
+        int findCell( double angle, SDL_RendererFlip flip );
+
+        LTexture* mSource;
+        LTexture mAtlas;
+        int mSteps;
+        int mCellSize;
+        bool mEnabled;
+        int mHits;
+        int mMisses;
+};
+
+LRotationCache::LRotationCache() {
+    mSource = NULL;
+    mSteps = 0;
+    mCellSize = 0;
+    mEnabled = true;
+    mHits = 0;
+    mMisses = 0;
+}
+
+bool LRotationCache::build( LTexture* source, int steps ) {
+    free();
+    mSource = source;
+
+    //Renderer must support drawing to textures
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo( gRenderer, &info );
+    if (!( info.flags & SDL_RENDERER_TARGETTEXTURE )) {
+        printf("Renderer can't render to textures, rotation cache disabled\n");
+        return false;
+    }
+
+    //A cell fits the sprite at any angle
+    int w = source->getWidth();
+    int h = source->getHeight();
+    mCellSize = (int) ceil( sqrt( (double) ( w * w + h * h ) ) );
+    if (!mAtlas.createBlank( mCellSize * steps, mCellSize * CACHED_FLIPS, SDL_TEXTUREACCESS_TARGET ))
+        return false;
+    mSteps = steps;
+
+    //Clear atlas to transparent and draw each orientation centered in its cell
+    mAtlas.setBlendMode( SDL_BLENDMODE_BLEND );
+    mAtlas.setAsRenderTarget();
+    SDL_SetRenderDrawColor( gRenderer, 0, 0, 0, 0 );
+    SDL_RenderClear( gRenderer );
+    for (int row = 0; row < CACHED_FLIPS; row++) {
+        for (int col = 0; col < steps; col++) {
+            int x = col * mCellSize + ( mCellSize - w ) / 2;
+            int y = row * mCellSize + ( mCellSize - h ) / 2;
+            source->render( x, y, NULL, col * 360.0 / steps, NULL, gCachedFlips[row] );
+        }
+    }
+    SDL_SetRenderTarget( gRenderer, NULL );
+    SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+    printf("Rotation cache: %d orientations in a %dx%d atlas\n", steps * CACHED_FLIPS, mAtlas.getWidth(), mAtlas.getHeight());
+    return true;
+}
+
+void LRotationCache::free() {
+    mAtlas.free();
+    mSteps = 0;
+}
+
+void LRotationCache::setEnabled( bool enabled ) {
+    mEnabled = enabled;
+}
+
+int LRotationCache::getHits() {
+    return mHits;
+}
+
+int LRotationCache::getMisses() {
+    return mMisses;
+}
+
+int LRotationCache::findCell( double angle, SDL_RendererFlip flip ) {
+    if (!mEnabled || mSteps == 0)
+        return -1;
+
+    int row = -1;
+    for (int i = 0; i < CACHED_FLIPS; i++) {
+        if (gCachedFlips[i] == flip)
+            row = i;
+    }
+    if (row < 0)
+        return -1;
+
+    //Wrap into [0, 360) and snap to the nearest step
+    double step = 360.0 / mSteps;
+    double wrapped = fmod( angle, 360.0 );
+    if (wrapped < 0)
+        wrapped += 360.0;
+    int col = (int) floor( wrapped / step + 0.5 );
+
+    //Only exact steps are served, anything else needs true rotation
+    if (fabs( wrapped - col * step ) > 0.001)
+        return -1;
+    return row * mSteps + col % mSteps;
+}
+
+void LRotationCache::render( int x, int y, double angle, SDL_RendererFlip flip ) {
+    int cell = findCell( angle, flip );
+    if (cell < 0) {
+        mMisses++;
+        mSource->render( x, y, NULL, angle, NULL, flip );
+        return;
+    }
+    mHits++;
+
+    //Cell is centered on the sprite's center
+    SDL_Rect clip = { ( cell % mSteps ) * mCellSize, ( cell / mSteps ) * mCellSize, mCellSize, mCellSize };
+    mAtlas.render( x + ( mSource->getWidth() - mCellSize ) / 2, y + ( mSource->getHeight() - mCellSize ) / 2, &clip );
+}
+
+LTexture gArrowTexture;
+LRotationCache gArrowCache;
+
+bool loadMedia() {
+    bool success = true;
+
+    //Load arrow texture
+    if ( !gArrowTexture.loadFromFile("arrow.png") ) {
+        printf("Failed to load arrow texture!\n");
+        success = false;
+    }
+    //Pre-render 60 degree steps, falling back to true rotation if it fails
+    else if ( !gArrowCache.build( &gArrowTexture, ROTATION_STEPS ) ) {
+        printf("Failed to build rotation cache!\n");
+    }
+    return success;
+}
+
+void close() {
+    gArrowCache.free();
+    gArrowTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+//Draws BENCH_SPRITES quantized rotations per frame and returns ms per frame
+double benchmark( bool cached ) {
+    gArrowCache.setEnabled( cached );
+
+    //Same sprites for both runs
+    srand( 7 );
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        SDL_RenderClear( gRenderer );
+        for (int i = 0; i < BENCH_SPRITES; i++) {
+            int x = rand() % SCREEN_WIDTH - gArrowTexture.getWidth() / 2;
+            int y = rand() % SCREEN_HEIGHT - gArrowTexture.getHeight() / 2;
+            double angle = ( rand() % ROTATION_STEPS ) * 360.0 / ROTATION_STEPS;
+            gArrowCache.render( x, y, angle, gCachedFlips[ rand() % CACHED_FLIPS ] );
+        }
+        SDL_RenderPresent( gRenderer );
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_FRAMES;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            //Compare true rotation against the atlas on identical frames
+            double rotated = benchmark( false );
+            double cached = benchmark( true );
+            printf("SDL_RenderCopyEx: %.3f ms/frame, %.0f sprites per 60Hz frame\n", rotated, BENCH_SPRITES * ( 1000.0 / 60.0 ) / rotated);
+            printf("Rotation cache:   %.3f ms/frame, %.0f sprites per 60Hz frame\n", cached, BENCH_SPRITES * ( 1000.0 / 60.0 ) / cached);
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            double degrees = 0;
+            SDL_RendererFlip flipType = SDL_FLIP_NONE;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT )
+                    {
+                        quit = true;
+                    }
+                    else if( e.type == SDL_KEYDOWN )
+                    {
+                        switch( e.key.keysym.sym )
+                        {
+                            case SDLK_a:
+                            degrees -= 60;
+                            break;
+
+                            case SDLK_d:
+                            degrees += 60;
+                            break;
+
+                            //Off-step angles fall back to true rotation
+                            case SDLK_s:
+                            degrees += 15;
+                            break;
+
+                            case SDLK_q:
+                            flipType = SDL_FLIP_HORIZONTAL;
+                            break;
+
+                            case SDLK_w:
+                            flipType = SDL_FLIP_NONE;
+                            break;
+
+                            case SDLK_e:
+                            flipType = SDL_FLIP_VERTICAL;
+                            break;
+                        }
+                    }
+
+
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the texture
+                gArrowCache.render((SCREEN_WIDTH - gArrowTexture.getWidth())/2, (SCREEN_HEIGHT - gArrowTexture.getHeight())/2, degrees, flipType);
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
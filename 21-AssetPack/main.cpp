@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include "pack.h"
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_ASSETS = 4;
+const char* gAssetFiles[ TOTAL_ASSETS ] = { "texture.png", "dots.png", "button.png", "sample.bmp" };
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Read only view of an asset pack mapped into memory
+class LAssetPack {
+    public:
+        //Initializes internal variables
+        LAssetPack();
+
+        //Unmaps pack
+        ~LAssetPack();
+
+        //Maps pack file and validates its index
+        bool open( std::string path );
+
+        //Unmaps pack, surfaces created from it must be freed first
+        void free();
+
+        //Creates a surface pointing straight into the mapping, NULL if missing
+        SDL_Surface* getSurface( std::string name );
+
+        //Gets pixel format of all entries
+        Uint32 getFormat();
+
+    private:
+        //Mapping and its size
+        Uint8* mData;
+        size_t mSize;
+
+        //Index inside the mapping
+        LPackHeader* mHeader;
+        LPackEntry* mEntries;
+};
+
+LAssetPack::LAssetPack() {
+    mData = NULL;
+    mSize = 0;
+    mHeader = NULL;
+    mEntries = NULL;
+}
+
+LAssetPack::~LAssetPack() {
+    free();
+}
+
+bool LAssetPack::open( std::string path ) {
+    free();
+
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file < 0) {
+        printf("Unable to open pack %s!\n", path.c_str());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat( file, &info ) < 0 || (size_t) info.st_size < sizeof( LPackHeader )) {
+        printf("Pack %s is truncated!\n", path.c_str());
+        ::close( file );
+        return false;
+    }
+
+    //Mapping stays valid after the descriptor is closed
+    void* data = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+    ::close( file );
+    if (data == MAP_FAILED) {
+        printf("Unable to map pack %s!\n", path.c_str());
+        return false;
+    }
+    mData = (Uint8*) data;
+    mSize = info.st_size;
+
+    //Validate header and index before handing out pointers
+    mHeader = (LPackHeader*) mData;
+    mEntries = (LPackEntry*) ( mData + sizeof( LPackHeader ) );
+    bool valid = mHeader->magic == PACK_MAGIC && mHeader->version == PACK_VERSION;
+    if (valid && sizeof( LPackHeader ) + (Uint64) mHeader->count * sizeof( LPackEntry ) > mSize)
+        valid = false;
+
+    //Rows are read as 4 bytes a pixel, so anything else would read past the mapping
+    if (valid && ( SDL_ISPIXELFORMAT_FOURCC( mHeader->format ) || SDL_BYTESPERPIXEL( mHeader->format ) != 4 ))
+        valid = false;
+    for (Uint32 i = 0; valid && i < mHeader->count; i++) {
+        LPackEntry& entry = mEntries[i];
+        if (entry.width == 0 || entry.height == 0 || entry.width > SDL_MAX_SINT32 / 4 || entry.height > SDL_MAX_SINT32 ||
+            entry.pitch < entry.width * 4 || entry.pitch > SDL_MAX_SINT32 ||
+            entry.offset > mSize || (Uint64) entry.pitch * entry.height > mSize - entry.offset ||
+            entry.name[ PACK_NAME_LENGTH - 1 ] != '\0')
+            valid = false;
+    }
+    if (!valid) {
+        printf("Pack %s is corrupt or from another version!\n", path.c_str());
+        free();
+        return false;
+    }
+    return true;
+}
+
+void LAssetPack::free() {
+    if (mData != NULL) {
+        munmap( mData, mSize );
+        mData = NULL;
+        mSize = 0;
+        mHeader = NULL;
+        mEntries = NULL;
+    }
+}
+
+SDL_Surface* LAssetPack::getSurface( std::string name ) {
+    if (mHeader == NULL)
+        return NULL;
+
+    for (Uint32 i = 0; i < mHeader->count; i++) {
+        LPackEntry& entry = mEntries[i];
+        if (name == entry.name) {
+            //Surface borrows the mapped pixels, no decode and no copy
+            return SDL_CreateRGBSurfaceWithFormatFrom( mData + entry.offset, entry.width, entry.height, SDL_BITSPERPIXEL( mHeader->format ), entry.pitch, mHeader->format );
+        }
+    }
+    printf("Pack has no entry named %s!\n", name.c_str());
+    return NULL;
+}
+
+Uint32 LAssetPack::getFormat() {
+    return mHeader != NULL ? mHeader->format : SDL_PIXELFORMAT_UNKNOWN;
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Load pre-decoded image from a mapped pack
+        bool loadFromPack( LAssetPack* pack, std::string name );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+bool LTexture::loadFromPack( LAssetPack* pack, std::string name ) {
+    //Delete the previous texture
+    free();
+
+    //Surface header over the mapped pixels, color key is already baked into alpha
+    SDL_Surface* packedSurface = pack->getSurface( name );
+    if (packedSurface == NULL)
+        printf("Unable to load %s from pack! SDL Error: %s\n", name.c_str(), SDL_GetError());
+    else {
+        mTexture = SDL_CreateTextureFromSurface( gRenderer, packedSurface );
+        if (mTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+        else {
+            mWidth = packedSurface->w;
+            mHeight = packedSurface->h;
+        }
+
+        //Frees the surface header only, pixels belong to the pack
+        SDL_FreeSurface( packedSurface );
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LAssetPack gAssetPack;
+LTexture gTextures[ TOTAL_ASSETS ];
+
+//Checks the pack was built for a format the renderer takes without converting
+void checkPackFormat() {
+    SDL_RendererInfo info;
+    SDL_GetRendererInfo( gRenderer, &info );
+    for (Uint32 i = 0; i < info.num_texture_formats; i++) {
+        if (info.texture_formats[i] == gAssetPack.getFormat())
+            return;
+    }
+    printf("Renderer %s does not take %s natively, uploads will convert\n", info.name, SDL_GetPixelFormatName( gAssetPack.getFormat() ));
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gAssetPack.open( "assets.pak" )) {
+        printf("Failed to open asset pack, run make pack first!\n");
+        success = false;
+    }
+    else {
+        checkPackFormat();
+        for (int i = 0; i < TOTAL_ASSETS; i++) {
+            if (!gTextures[i].loadFromPack( &gAssetPack, gAssetFiles[i] )) {
+                printf("Failed to load %s!\n", gAssetFiles[i]);
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+//Asks the kernel to drop cached pages of a file so the next read is cold
+void evictFromPageCache( std::string path ) {
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file >= 0) {
+        posix_fadvise( file, 0, 0, POSIX_FADV_DONTNEED );
+        ::close( file );
+    }
+}
+
+//Loads every asset once and returns ms taken
+double timeLoad( bool fromPack, bool cold ) {
+    if (cold) {
+        for (int i = 0; i < TOTAL_ASSETS; i++)
+            evictFromPageCache( gAssetFiles[i] );
+        evictFromPageCache( "assets.pak" );
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    LAssetPack pack;
+    LTexture textures[ TOTAL_ASSETS ];
+    if (fromPack)
+        pack.open( "assets.pak" );
+    for (int i = 0; i < TOTAL_ASSETS; i++) {
+        if (fromPack)
+            textures[i].loadFromPack( &pack, gAssetFiles[i] );
+        else
+            textures[i].loadFromFile( gAssetFiles[i] );
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void benchmark() {
+    //Mapped pages are never dropped, so the pack loadMedia mapped must go first
+    for (int i = 0; i < TOTAL_ASSETS; i++)
+        gTextures[i].free();
+    gAssetPack.free();
+
+    //Cold runs drop the page cache first, best effort without root
+    double coldFiles = timeLoad( false, true );
+    double coldPack = timeLoad( true, true );
+
+    //Warm runs read from the page cache left by the runs above
+    double warmFiles = timeLoad( false, false );
+    double warmPack = timeLoad( true, false );
+
+    printf("             loose files   asset pack\n");
+    printf("cold start  %10.3f ms %10.3f ms\n", coldFiles, coldPack);
+    printf("warm start  %10.3f ms %10.3f ms\n", warmFiles, warmPack);
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_ASSETS; i++)
+        gTextures[i].free();
+    gAssetPack.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Loose file loading still needs png support for comparison
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (argc > 1 && strcmp( args[1], "--bench" ) == 0) {
+            benchmark();
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            SDL_Rect buttonClip = { 0, 0, 300, 200 };
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render every packed image
+                gTextures[0].render( 0, 0 );
+                gTextures[1].render( 0, 0 );
+                gTextures[2].render( SCREEN_WIDTH - buttonClip.w, SCREEN_HEIGHT - buttonClip.h, &buttonClip );
+                gTextures[3].render( ( SCREEN_WIDTH - gTextures[3].getWidth() ) / 2, ( SCREEN_HEIGHT - gTextures[3].getHeight() ) / 2 );
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <SDL2/SDL.h>
+
+//Pack layout: LPackHeader, then count LPackEntry records, then pixel data
+//Pixel data of each entry starts on a PACK_ALIGNMENT boundary
+const Uint32 PACK_MAGIC = 0x4B41504C; //"LPAK"
+const Uint32 PACK_VERSION = 1;
+const int PACK_NAME_LENGTH = 48;
+const int PACK_ALIGNMENT = 64;
+
+//Pixel format images are stored in, the first format most renderers list
+const Uint32 PACK_PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+struct LPackHeader {
+    Uint32 magic;
+    Uint32 version;
+
+    //SDL_PixelFormatEnum of every entry
+    Uint32 format;
+
+    //Number of entries
+    Uint32 count;
+};
+
+struct LPackEntry {
+    //File name the image was packed from
+    char name[ PACK_NAME_LENGTH ];
+
+    //Image dimensions and bytes per row
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+    Uint32 reserved;
+
+    //Start of pixels from the beginning of the pack
+    Uint64 offset;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include "pack.h"
+
+//Decodes an image and converts it to the pack's pixel format
+SDL_Surface* loadConverted( std::string path ) {
+    SDL_Surface* convertedSurface = NULL;
+
+    SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+    if (loadedSurface == NULL)
+        printf("Unable to load %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+    else {
+        //Bake the lessons' cyan color key into alpha
+        SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+        convertedSurface = SDL_ConvertSurfaceFormat( loadedSurface, PACK_PIXEL_FORMAT, 0 );
+        if (convertedSurface == NULL)
+            printf("Unable to convert %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        SDL_FreeSurface( loadedSurface );
+    }
+    return convertedSurface;
+}
+
+//Pads the file with zeros up to the next alignment boundary
+void writePadding( FILE* file, Uint64 offset ) {
+    static const char zeros[ PACK_ALIGNMENT ] = { 0 };
+    Uint64 padding = ( PACK_ALIGNMENT - offset % PACK_ALIGNMENT ) % PACK_ALIGNMENT;
+    fwrite( zeros, 1, padding, file );
+}
+
+int main( int argc, char *args[] ) {
+    if (argc < 3) {
+        printf("Usage: %s <pack> <image>...\n", args[0]);
+        return 1;
+    }
+
+    if ( !( IMG_Init( IMG_INIT_PNG ) & IMG_INIT_PNG ) ) {
+        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        return 1;
+    }
+
+    //Decode everything up front so the index can be written first
+    std::vector<SDL_Surface*> surfaces;
+    std::vector<LPackEntry> entries;
+    bool success = true;
+    for (int i = 2; i < argc; i++) {
+        SDL_Surface* surface = loadConverted( args[i] );
+        if (surface == NULL) {
+            success = false;
+            break;
+        }
+
+        //Entries are looked up by file name without directories
+        std::string path = args[i];
+        std::string name = path.substr( path.find_last_of( '/' ) + 1 );
+        if (name.size() >= PACK_NAME_LENGTH) {
+            printf("Name %s is too long for the pack!\n", name.c_str());
+            SDL_FreeSurface( surface );
+            success = false;
+            break;
+        }
+
+        LPackEntry entry;
+        memset( &entry, 0, sizeof( entry ) );
+        strcpy( entry.name, name.c_str() );
+        entry.width = surface->w;
+        entry.height = surface->h;
+        entry.pitch = surface->pitch;
+        surfaces.push_back( surface );
+        entries.push_back( entry );
+    }
+
+    //Lay out pixel data after the index
+    Uint64 offset = sizeof( LPackHeader ) + entries.size() * sizeof( LPackEntry );
+    for (size_t i = 0; i < entries.size(); i++) {
+        offset += ( PACK_ALIGNMENT - offset % PACK_ALIGNMENT ) % PACK_ALIGNMENT;
+        entries[i].offset = offset;
+        offset += (Uint64) entries[i].pitch * entries[i].height;
+    }
+
+    FILE* file = NULL;
+    if (success) {
+        file = fopen( args[1], "wb" );
+        if (file == NULL) {
+            printf("Unable to open %s for writing!\n", args[1]);
+            success = false;
+        }
+    }
+
+    if (success) {
+        LPackHeader header;
+        header.magic = PACK_MAGIC;
+        header.version = PACK_VERSION;
+        header.format = PACK_PIXEL_FORMAT;
+        header.count = entries.size();
+        fwrite( &header, sizeof( header ), 1, file );
+        fwrite( entries.data(), sizeof( LPackEntry ), entries.size(), file );
+
+        Uint64 written = sizeof( LPackHeader ) + entries.size() * sizeof( LPackEntry );
+        for (size_t i = 0; i < entries.size(); i++) {
+            writePadding( file, written );
+            written = entries[i].offset;
+
+            //Rows keep their pitch padding so the loader can map them as is
+            SDL_Surface* surface = surfaces[i];
+            fwrite( surface->pixels, surface->pitch, surface->h, file );
+            written += (Uint64) surface->pitch * surface->h;
+            printf("%s: %dx%d, %d bytes at %llu\n", entries[i].name, surface->w, surface->h, surface->pitch * surface->h, (unsigned long long) entries[i].offset);
+        }
+
+        if (fclose( file ) != 0) {
+            printf("Unable to write %s!\n", args[1]);
+            success = false;
+        }
+        else
+            printf("Wrote %d images in %s to %s\n", (int) entries.size(), SDL_GetPixelFormatName( PACK_PIXEL_FORMAT ), args[1]);
+    }
+
+    for (size_t i = 0; i < surfaces.size(); i++)
+        SDL_FreeSurface( surfaces[i] );
+    IMG_Quit();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,419 @@
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Records wall time of startup phases
+class LStartupTrace {
+    public:
+        //Starts the clock
+        LStartupTrace();
+
+        //Opens a phase and returns its id for end()
+        int begin( std::string name, std::string category );
+
+        //Closes a phase
+        void end( int id );
+
+        //Prints one line with the top level phases
+        void printSummary();
+
+        //Writes all phases as Chrome trace events
+        bool writeChromeTrace( std::string path );
+
+    private:
+        struct Phase {
+            std::string name;
+            std::string category;
+
+            //Microseconds since the trace started
+            double start;
+            double duration;
+
+            //Nesting depth when opened
+            int depth;
+        };
+
+        //Microseconds since the trace started
+        double now();
+
+        std::vector<Phase> mPhases;
+        Uint64 mOrigin;
+        int mDepth;
+};
+
+LStartupTrace::LStartupTrace() {
+    mOrigin = SDL_GetPerformanceCounter();
+    mDepth = 0;
+}
+
+double LStartupTrace::now() {
+    return ( SDL_GetPerformanceCounter() - mOrigin ) * 1000000.0 / SDL_GetPerformanceFrequency();
+}
+
+int LStartupTrace::begin( std::string name, std::string category ) {
+    Phase phase;
+    phase.name = name;
+    phase.category = category;
+    phase.start = now();
+    phase.duration = 0;
+    phase.depth = mDepth++;
+    mPhases.push_back( phase );
+    return (int) mPhases.size() - 1;
+}
+
+void LStartupTrace::end( int id ) {
+    mPhases[id].duration = now() - mPhases[id].start;
+    mDepth--;
+}
+
+void LStartupTrace::printSummary() {
+    //Time to first frame is the end of the last top level phase
+    double total = 0;
+    std::string line;
+    char part[128];
+    for (size_t i = 0; i < mPhases.size(); i++) {
+        Phase& phase = mPhases[i];
+        if (phase.depth != 0)
+            continue;
+        if (phase.start + phase.duration > total)
+            total = phase.start + phase.duration;
+        snprintf( part, sizeof( part ), ", %s %.2f ms", phase.name.c_str(), phase.duration / 1000.0 );
+        line += part;
+    }
+    printf("Startup: %.2f ms to first frame%s\n", total / 1000.0, line.c_str());
+
+    //Slowest single asset is usually what to attack first
+    int slowest = -1;
+    for (size_t i = 0; i < mPhases.size(); i++) {
+        if (mPhases[i].category == "asset" && ( slowest < 0 || mPhases[i].duration > mPhases[slowest].duration ))
+            slowest = i;
+    }
+    if (slowest >= 0)
+        printf("Slowest asset step: %s %.2f ms\n", mPhases[slowest].name.c_str(), mPhases[slowest].duration / 1000.0);
+}
+
+bool LStartupTrace::writeChromeTrace( std::string path ) {
+    FILE* file = fopen( path.c_str(), "w" );
+    if (file == NULL) {
+        printf("Unable to write trace %s!\n", path.c_str());
+        return false;
+    }
+
+    //Complete events, names are ours so they need no escaping
+    fprintf( file, "{\"traceEvents\":[\n" );
+    for (size_t i = 0; i < mPhases.size(); i++) {
+        Phase& phase = mPhases[i];
+        fprintf( file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.1f,\"dur\":%.1f,\"pid\":1,\"tid\":1}%s\n", phase.name.c_str(), phase.category.c_str(), phase.start, phase.duration, i + 1 < mPhases.size() ? "," : "" );
+    }
+    fprintf( file, "],\"displayTimeUnit\":\"ms\"}\n" );
+    fclose( file );
+    return true;
+}
+
+LStartupTrace gStartupTrace;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Creates image from font string
+        bool loadFromRenderedText(std::string textureText, SDL_Color textColor);
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    int decode = gStartupTrace.begin( "decode " + path, "asset" );
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    gStartupTrace.end( decode );
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        int upload = gStartupTrace.begin( "upload " + path, "asset" );
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        gStartupTrace.end( upload );
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    int rasterize = gStartupTrace.begin( "rasterize text", "asset" );
+    SDL_Surface* textSurface = TTF_RenderText_Solid(gFont, textureText.c_str(), textColor);
+    gStartupTrace.end( rasterize );
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        int upload = gStartupTrace.begin( "upload text", "asset" );
+        mTexture = SDL_CreateTextureFromSurface(gRenderer, textSurface);
+        gStartupTrace.end( upload );
+        if (mTexture == NULL)
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        else {
+            //Set image dimensions
+            mWidth = textSurface->w;
+            mHeight = textSurface->h;
+        }
+        SDL_FreeSurface(textSurface);
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gBackgroundTexture;
+LTexture gDotsTexture;
+LTexture gTextTexture;
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gBackgroundTexture.loadFromFile("texture.png")) {
+        printf("Failed to load background texture!\n");
+        success = false;
+    }
+
+    if (!gDotsTexture.loadFromFile("dots.png")) {
+        printf("Failed to load dots texture!\n");
+        success = false;
+    }
+
+    //Load font
+    int fontPhase = gStartupTrace.begin( "open lazy.ttf", "asset" );
+    gFont = TTF_OpenFont("lazy.ttf", 28);
+    gStartupTrace.end( fontPhase );
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    //render the text
+    else {
+        SDL_Color textColor = {0, 0, 0};
+        if (!gTextTexture.loadFromRenderedText("The quick brown fox jumps over the lazy dog", textColor)) {
+            printf("Error loading the text!\n");
+            success = false;
+        }
+    }
+    return success;
+}
+
+void close() {
+    gBackgroundTexture.free();
+    gDotsTexture.free();
+    gTextTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    int phase = gStartupTrace.begin( "SDL_Init", "init" );
+    int result = SDL_Init( SDL_INIT_VIDEO );
+    gStartupTrace.end( phase );
+    if ( result < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        phase = gStartupTrace.begin( "SDL_CreateWindow", "init" );
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        gStartupTrace.end( phase );
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            phase = gStartupTrace.begin( "SDL_CreateRenderer", "init" );
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            gStartupTrace.end( phase );
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                phase = gStartupTrace.begin( "IMG_Init", "init" );
+                int imgLoaded = IMG_Init( imgFlags );
+                gStartupTrace.end( phase );
+                if ( !( imgLoaded & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+
+                phase = gStartupTrace.begin( "TTF_Init", "init" );
+                result = TTF_Init();
+                gStartupTrace.end( phase );
+                if (result == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    int initPhase = gStartupTrace.begin( "init", "startup" );
+    bool initialized = init();
+    gStartupTrace.end( initPhase );
+    if (!initialized) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        int loadPhase = gStartupTrace.begin( "loadMedia", "startup" );
+        bool loaded = loadMedia();
+        gStartupTrace.end( loadPhase );
+        if ( !loaded ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            bool firstFrame = true;
+            SDL_Event e; //Variable to Store Event
+            int framePhase = gStartupTrace.begin( "first frame", "startup" );
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the textures
+                gBackgroundTexture.render( 0, 0 );
+                gDotsTexture.render( 0, 0 );
+                gTextTexture.render((SCREEN_WIDTH - gTextTexture.getWidth())/2, (SCREEN_HEIGHT - gTextTexture.getHeight())/2);
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                //Startup ends once the first frame is presented
+                if (firstFrame) {
+                    gStartupTrace.end( framePhase );
+                    gStartupTrace.printSummary();
+                    gStartupTrace.writeChromeTrace( "startup_trace.json" );
+                    firstFrame = false;
+                }
+            }
+        }
+    }
+    close();
+    return 0;
+}
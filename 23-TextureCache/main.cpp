@@ -0,0 +1,485 @@
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <map>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int BUTTON_HEIGHT = 200;
+const int BUTTON_WIDTH = 300;
+const int TOTAL_BUTTONS = 4;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+enum LButtonSprite {
+    BUTTON_SPRITE_MOUSE_OUT,
+    BUTTON_SPRITE_MOUSE_OVER_MOTION,
+    BUTTON_SPRITE_MOUSE_DOWN,
+    BUTTON_SPRITE_MOUSE_UP,
+    BUTTON_SPRITE_TOTAL
+};
+
+//Texture shared by every load of the same content
+struct LCachedTexture {
+    SDL_Texture* texture;
+    int width;
+    int height;
+
+    //Size of the texture in bytes
+    size_t bytes;
+
+    //Content key
+    Uint64 hash;
+
+    //Number of LTextures holding this entry
+    int refCount;
+};
+
+//Decodes and uploads each distinct image once
+class LTextureCache {
+    public:
+        //Initializes internal variables
+        LTextureCache();
+
+        //Gets a shared texture for path, decoding only on first sight of its content
+        LCachedTexture* acquire( std::string path );
+
+        //Drops a reference, destroying the texture with the last one
+        void release( LCachedTexture* entry );
+
+        //Prints hit and miss counts and bytes saved
+        void printStats();
+
+    private:
+        //Decodes file contents into a new entry
+        LCachedTexture* create( std::vector<Uint8>& contents, Uint64 hash );
+
+        //Entries by path as requested and by content hash
+        std::map<std::string, LCachedTexture*> mByPath;
+        std::map<Uint64, LCachedTexture*> mByHash;
+
+        int mHits;
+        int mMisses;
+        size_t mBytesSaved;
+};
+
+//Reads a whole file, false if it can't be read
+bool readFile( std::string path, std::vector<Uint8>& contents ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL)
+        return false;
+
+    Sint64 size = SDL_RWsize( file );
+    bool success = size >= 0;
+    if (success) {
+        contents.resize( size );
+        success = size == 0 || SDL_RWread( file, contents.data(), size, 1 ) == 1;
+    }
+    SDL_RWclose( file );
+    return success;
+}
+
+//64-bit FNV-1a over the file bytes, length folded in to separate prefixes
+Uint64 hashContents( std::vector<Uint8>& contents ) {
+    Uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < contents.size(); i++) {
+        hash ^= contents[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ contents.size();
+}
+
+LTextureCache::LTextureCache() {
+    mHits = 0;
+    mMisses = 0;
+    mBytesSaved = 0;
+}
+
+LCachedTexture* LTextureCache::create( std::vector<Uint8>& contents, Uint64 hash ) {
+    LCachedTexture* entry = NULL;
+
+    //Decode straight from the bytes we already hashed
+    SDL_Surface* loadedSurface = IMG_Load_RW( SDL_RWFromConstMem( contents.data(), contents.size() ), 1 );
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+    else {
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (texture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+        else {
+            entry = new LCachedTexture;
+            entry->texture = texture;
+            entry->width = loadedSurface->w;
+            entry->height = loadedSurface->h;
+            entry->hash = hash;
+            entry->refCount = 0;
+
+            //Size as stored by the renderer, not the file
+            Uint32 format;
+            SDL_QueryTexture( texture, &format, NULL, NULL, NULL );
+            entry->bytes = (size_t) entry->width * entry->height * SDL_BYTESPERPIXEL( format );
+        }
+        SDL_FreeSurface(loadedSurface);
+    }
+    return entry;
+}
+
+LCachedTexture* LTextureCache::acquire( std::string path ) {
+    //Same path as before, files are assumed not to change while loaded
+    std::map<std::string, LCachedTexture*>::iterator byPath = mByPath.find( path );
+    if (byPath != mByPath.end()) {
+        LCachedTexture* entry = byPath->second;
+        entry->refCount++;
+        mHits++;
+        mBytesSaved += entry->bytes;
+        return entry;
+    }
+
+    std::vector<Uint8> contents;
+    if (!readFile( path, contents )) {
+        printf("Unable to read %s!\n", path.c_str());
+        return NULL;
+    }
+
+    //Different path with content we already have
+    Uint64 hash = hashContents( contents );
+    LCachedTexture* entry = NULL;
+    std::map<Uint64, LCachedTexture*>::iterator byHash = mByHash.find( hash );
+    if (byHash != mByHash.end()) {
+        entry = byHash->second;
+        mHits++;
+        mBytesSaved += entry->bytes;
+    }
+    else {
+        entry = create( contents, hash );
+        if (entry == NULL)
+            return NULL;
+        mByHash[hash] = entry;
+        mMisses++;
+    }
+
+    mByPath[path] = entry;
+    entry->refCount++;
+    return entry;
+}
+
+void LTextureCache::release( LCachedTexture* entry ) {
+    if (--entry->refCount > 0)
+        return;
+
+    //Last holder gone, forget every path that led here
+    std::map<std::string, LCachedTexture*>::iterator it = mByPath.begin();
+    while (it != mByPath.end()) {
+        if (it->second == entry)
+            mByPath.erase( it++ );
+        else
+            ++it;
+    }
+    mByHash.erase( entry->hash );
+    SDL_DestroyTexture( entry->texture );
+    delete entry;
+}
+
+void LTextureCache::printStats() {
+    printf("Texture cache: %d hits, %d misses, %d textures resident, %.1f KB saved\n", mHits, mMisses, (int) mByHash.size(), mBytesSaved / 1024.0);
+}
+
+LTextureCache gTextureCache;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture, shared with other loads of the same image
+        bool loadFromFile( std::string path );
+
+        //Releases shared texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Shared hardware texture
+        LCachedTexture* mEntry;
+};
+
+LTexture::LTexture() {
+    mEntry = NULL;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Release the previous texture
+    free();
+    mEntry = gTextureCache.acquire( path );
+    return mEntry != NULL;
+}
+
+void LTexture::free() {
+    //Release texture if we hold one
+    if (mEntry != NULL) {
+        gTextureCache.release( mEntry );
+        mEntry = NULL;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    if (mEntry == NULL)
+        return;
+
+    SDL_Rect renderquad = { x, y, mEntry->width, mEntry->height };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mEntry->texture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mEntry != NULL ? mEntry->height : 0;
+}
+
+int LTexture::getWidth() {
+    return mEntry != NULL ? mEntry->width : 0;
+}
+
+SDL_Rect gSpriteClips[BUTTON_SPRITE_TOTAL];
+
+class LButton {
+    public:
+        //Initializes internal variables
+        LButton();
+
+        //Loads the button's own sprite sheet
+        bool loadMedia( std::string path );
+
+        //Releases sprite sheet
+        void free();
+
+        //Set top left position
+        void setPosition( int x, int y );
+
+        //Handles mouse event
+        void handleEvent( SDL_Event* e );
+
+        //Shows button sprite
+        void render();
+
+    private:
+        //Top left position
+        SDL_Point mPosition;
+
+        //Currently used global sprite
+        LButtonSprite mCurrentSprite;
+
+        //Sprite sheet, shared through the cache
+        LTexture mSpriteSheet;
+};
+
+LButton::LButton() {
+    mPosition.x = 0;
+    mPosition.y = 0;
+
+    mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
+}
+
+bool LButton::loadMedia( std::string path ) {
+    return mSpriteSheet.loadFromFile( path );
+}
+
+void LButton::free() {
+    mSpriteSheet.free();
+}
+
+void LButton::setPosition(int x, int y) {
+    mPosition.x = x;
+    mPosition.y = y;
+}
+
+void LButton::handleEvent(SDL_Event* e) {
+    //If mouse event happend
+    if ( e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN || e->type == SDL_MOUSEBUTTONUP ) {
+        //Get mouse position
+        int x, y;
+        SDL_GetMouseState( &x, &y );
+        bool inside = false;
+
+        //Check if mouse is inside button
+        if (x >= mPosition.x && x <= mPosition.x + BUTTON_WIDTH && y >= mPosition.y && y <= mPosition.y + BUTTON_HEIGHT)
+            inside = true;
+
+        //Mouse is outside button
+        if (!inside)
+            mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
+
+        //Mouse is inside button
+        else {
+            //Set mouse over sprite
+            switch( e->type ) {
+                case SDL_MOUSEMOTION:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_OVER_MOTION;
+                break;
+
+                case SDL_MOUSEBUTTONDOWN:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_DOWN;
+                break;
+
+                case SDL_MOUSEBUTTONUP:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_UP;
+                break;
+            }
+        }
+
+    }
+}
+
+void LButton::render() {
+    //Show current button sprite
+    mSpriteSheet.render( mPosition.x, mPosition.y, &gSpriteClips[ mCurrentSprite ] );
+}
+
+LButton gButtons[TOTAL_BUTTONS];
+
+void initSpriteClips() {
+    for (int i = 0; i < BUTTON_SPRITE_TOTAL; i++) {
+        gSpriteClips[i].x = 0;
+        gSpriteClips[i].y = i*200;
+        gSpriteClips[i].w = BUTTON_WIDTH;
+        gSpriteClips[i].h = BUTTON_HEIGHT;
+    }
+}
+
+void initButtonLocations() {
+    //Set button locations
+    gButtons[0].setPosition(0, 0);
+    gButtons[1].setPosition(SCREEN_WIDTH - BUTTON_WIDTH, 0);
+    gButtons[2].setPosition(0, SCREEN_HEIGHT - BUTTON_HEIGHT);
+    gButtons[3].setPosition(SCREEN_WIDTH - BUTTON_WIDTH, SCREEN_HEIGHT - BUTTON_HEIGHT);
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    //Every button loads its own sheet, the last through another path to the same file
+    const char* paths[TOTAL_BUTTONS] = { "button.png", "button.png", "button.png", "./button.png" };
+    for (int i = 0; i < TOTAL_BUTTONS; i++) {
+        if (!gButtons[i].loadMedia( paths[i] )) {
+            printf("Error importing texture!\n");
+            success = false;
+        }
+    }
+
+    gTextureCache.printStats();
+    return success;
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_BUTTONS; i++)
+        gButtons[i].free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            initSpriteClips();
+            initButtonLocations();
+            SDL_Event e; //Variable to Store Event
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+
+                    for (int i = 0; i < TOTAL_BUTTONS; i++)
+                        gButtons[i].handleEvent( &e );
+                }
+                 //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the buttons
+                for (int i = 0; i < TOTAL_BUTTONS; i++)
+                    gButtons[i].render();
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
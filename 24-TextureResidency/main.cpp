@@ -0,0 +1,396 @@
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <list>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_IMAGES = 6;
+const size_t TEXTURE_BUDGET = 4 * 1024 * 1024;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+class LTexture;
+
+//Residency counters
+struct LResidencyStats {
+    size_t residentBytes;
+    int residentTextures;
+    int evictions;
+    int reloads;
+
+    //Time render() spent waiting on reloads
+    double reloadStallMs;
+    double worstStallMs;
+};
+
+//Keeps loaded textures under a byte budget, least recently rendered go first
+class LResidencyManager {
+    public:
+        //Initializes internal variables
+        LResidencyManager();
+
+        //Sets the byte budget, evicting if already over it
+        void setBudget( size_t bytes );
+
+        //Frees space for a texture of the given size
+        void makeRoom( size_t bytes );
+
+        //Tracks a texture that just became resident
+        void add( LTexture* texture, size_t bytes );
+
+        //Stops tracking a texture that is no longer resident
+        void remove( LTexture* texture, size_t bytes );
+
+        //Marks texture as most recently rendered
+        void touch( LTexture* texture );
+
+        //Records a reload that stalled rendering
+        void recordReload( double ms );
+
+        //Gets counters
+        LResidencyStats getStats();
+
+    private:
+        //Most recently rendered at the front
+        std::list<LTexture*> mLRU;
+        size_t mBudget;
+        LResidencyStats mStats;
+};
+
+LResidencyManager gResidency;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture, remembering path for reloads
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture and forgets its path
+        void free();
+
+        //Drops the hardware texture, render() brings it back
+        void evict();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+        //Checks if hardware texture is loaded
+        bool isResident();
+
+        //Position in the residency list
+        std::list<LTexture*>::iterator mLRUEntry;
+
+    private:
+        //Decodes and uploads mPath
+        bool load();
+
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Where to reload from
+        std::string mPath;
+
+        //Bytes held by mTexture
+        size_t mBytes;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LResidencyManager::LResidencyManager() {
+    mBudget = 0;
+    mStats.residentBytes = 0;
+    mStats.residentTextures = 0;
+    mStats.evictions = 0;
+    mStats.reloads = 0;
+    mStats.reloadStallMs = 0;
+    mStats.worstStallMs = 0;
+}
+
+void LResidencyManager::setBudget( size_t bytes ) {
+    mBudget = bytes;
+    makeRoom( 0 );
+}
+
+void LResidencyManager::makeRoom( size_t bytes ) {
+    //Budget of zero means unlimited
+    while (mBudget > 0 && !mLRU.empty() && mStats.residentBytes + bytes > mBudget) {
+        mLRU.back()->evict();
+        mStats.evictions++;
+    }
+}
+
+void LResidencyManager::add( LTexture* texture, size_t bytes ) {
+    mLRU.push_front( texture );
+    texture->mLRUEntry = mLRU.begin();
+    mStats.residentBytes += bytes;
+    mStats.residentTextures++;
+}
+
+void LResidencyManager::remove( LTexture* texture, size_t bytes ) {
+    mLRU.erase( texture->mLRUEntry );
+    mStats.residentBytes -= bytes;
+    mStats.residentTextures--;
+}
+
+void LResidencyManager::touch( LTexture* texture ) {
+    mLRU.splice( mLRU.begin(), mLRU, texture->mLRUEntry );
+}
+
+void LResidencyManager::recordReload( double ms ) {
+    mStats.reloads++;
+    mStats.reloadStallMs += ms;
+    if (ms > mStats.worstStallMs)
+        mStats.worstStallMs = ms;
+}
+
+LResidencyStats LResidencyManager::getStats() {
+    return mStats;
+}
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mBytes = 0;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    mPath = path;
+    return load();
+}
+
+bool LTexture::load() {
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(mPath.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Make room before the upload, assuming 4 bytes per pixel until the renderer picks a format
+        gResidency.makeRoom( (size_t) loadedSurface->w * loadedSurface->h * 4 );
+
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+
+            //Size as stored by the renderer
+            Uint32 format;
+            SDL_QueryTexture( newTexture, &format, NULL, NULL, NULL );
+            mBytes = (size_t) mWidth * mHeight * SDL_BYTESPERPIXEL( format );
+            gResidency.add( this, mBytes );
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::evict() {
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        gResidency.remove( this, mBytes );
+        mBytes = 0;
+    }
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    evict();
+    mPath.clear();
+    mHeight = 0;
+    mWidth = 0;
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    //Bring evicted texture back, timing the stall
+    if (mTexture == NULL) {
+        if (mPath.empty())
+            return;
+        Uint64 start = SDL_GetPerformanceCounter();
+        bool loaded = load();
+        gResidency.recordReload( ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() );
+        if (!loaded)
+            return;
+    }
+    gResidency.touch( this );
+
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+bool LTexture::isResident() {
+    return mTexture != NULL;
+}
+
+LTexture gImages[ TOTAL_IMAGES ];
+const char* gImageFiles[ TOTAL_IMAGES ] = { "texture.png", "loaded.png", "viewport.png", "colors.png", "fadein.png", "background.png" };
+
+void printStats( int current ) {
+    LResidencyStats stats = gResidency.getStats();
+    printf("Showing %s: %d textures resident, %.2f of %.2f MB, %d evictions, %d reloads stalling %.2f ms (worst %.2f ms)\n",
+        gImageFiles[current], stats.residentTextures, stats.residentBytes / 1048576.0, TEXTURE_BUDGET / 1048576.0,
+        stats.evictions, stats.reloads, stats.reloadStallMs, stats.worstStallMs);
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    //Six 640x480 images but room for only three
+    gResidency.setBudget( TEXTURE_BUDGET );
+    for (int i = 0; i < TOTAL_IMAGES; i++) {
+        if (!gImages[i].loadFromFile( gImageFiles[i] )) {
+            printf("Failed to load %s!\n", gImageFiles[i]);
+            success = false;
+        }
+    }
+    return success;
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_IMAGES; i++)
+        gImages[i].free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int current = 0;
+            printStats( current );
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Arrow keys step through the images
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch( e.key.keysym.sym ) {
+                            case SDLK_RIGHT:
+                            current = ( current + 1 ) % TOTAL_IMAGES;
+                            break;
+
+                            case SDLK_LEFT:
+                            current = ( current + TOTAL_IMAGES - 1 ) % TOTAL_IMAGES;
+                            break;
+                        }
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Reloads transparently if this image was evicted
+                bool wasResident = gImages[current].isResident();
+                gImages[current].render( 0, 0 );
+                if (!wasResident)
+                    printStats( current );
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,405 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int BENCH_UPDATES = 1000;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Pool usage counters
+struct LPoolStats {
+    int created;
+    int reused;
+    int idle;
+};
+
+//Streaming textures recycled by format and power of two size
+class LTexturePool {
+    public:
+        //Initializes internal variables
+        LTexturePool();
+
+        //Gets a streaming texture at least width x height
+        SDL_Texture* acquire( Uint32 format, int width, int height );
+
+        //Returns a texture from acquire() for reuse
+        void release( SDL_Texture* texture );
+
+        //Destroys idle textures
+        void free();
+
+        //Gets counters
+        LPoolStats getStats();
+
+    private:
+        //Idle textures of one format and size
+        struct Bucket {
+            Uint32 format;
+            int width;
+            int height;
+            std::vector<SDL_Texture*> idle;
+        };
+
+        //Finds or adds the bucket for a format and size
+        Bucket& getBucket( Uint32 format, int width, int height );
+
+        std::vector<Bucket> mBuckets;
+        LPoolStats mStats;
+};
+
+//Rounds up to a power of two
+int nextPowerOfTwo( int value ) {
+    int power = 1;
+    while (power < value)
+        power <<= 1;
+    return power;
+}
+
+LTexturePool::LTexturePool() {
+    mStats.created = 0;
+    mStats.reused = 0;
+    mStats.idle = 0;
+}
+
+LTexturePool::Bucket& LTexturePool::getBucket( Uint32 format, int width, int height ) {
+    for (size_t i = 0; i < mBuckets.size(); i++) {
+        Bucket& bucket = mBuckets[i];
+        if (bucket.format == format && bucket.width == width && bucket.height == height)
+            return bucket;
+    }
+    Bucket bucket;
+    bucket.format = format;
+    bucket.width = width;
+    bucket.height = height;
+    mBuckets.push_back( bucket );
+    return mBuckets.back();
+}
+
+SDL_Texture* LTexturePool::acquire( Uint32 format, int width, int height ) {
+    Bucket& bucket = getBucket( format, nextPowerOfTwo( width ), nextPowerOfTwo( height ) );
+    if (!bucket.idle.empty()) {
+        SDL_Texture* texture = bucket.idle.back();
+        bucket.idle.pop_back();
+        mStats.reused++;
+        mStats.idle--;
+        return texture;
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture( gRenderer, format, SDL_TEXTUREACCESS_STREAMING, bucket.width, bucket.height );
+    if (texture == NULL)
+        printf("Unable to create pooled texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+        mStats.created++;
+    }
+    return texture;
+}
+
+void LTexturePool::release( SDL_Texture* texture ) {
+    Uint32 format;
+    int width, height;
+    SDL_QueryTexture( texture, &format, NULL, &width, &height );
+    getBucket( format, width, height ).idle.push_back( texture );
+    mStats.idle++;
+}
+
+void LTexturePool::free() {
+    for (size_t i = 0; i < mBuckets.size(); i++) {
+        for (size_t j = 0; j < mBuckets[i].idle.size(); j++)
+            SDL_DestroyTexture( mBuckets[i].idle[j] );
+    }
+    mBuckets.clear();
+    mStats.idle = 0;
+}
+
+LPoolStats LTexturePool::getStats() {
+    return mStats;
+}
+
+LTexturePool gTexturePool;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Dealocates texture
+        void free();
+
+        //Creates image from font string in a fresh texture
+        bool loadFromRenderedText(std::string textureText, SDL_Color textColor);
+
+        //Creates image from font string in a recycled texture
+        bool loadFromRenderedTextPooled(std::string textureText, SDL_Color textColor);
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Texture belongs to gTexturePool and may be larger than the image
+        bool mPooled;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mPooled = false;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        if (mPooled)
+            gTexturePool.release( mTexture );
+        else
+            SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mPooled = false;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    SDL_Surface* textSurface = TTF_RenderText_Blended(gFont, textureText.c_str(), textColor);
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        mTexture = SDL_CreateTextureFromSurface(gRenderer, textSurface);
+        if (mTexture == NULL)
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        else {
+            //Set image dimensions
+            mWidth = textSurface->w;
+            mHeight = textSurface->h;
+        }
+        SDL_FreeSurface(textSurface);
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+bool LTexture::loadFromRenderedTextPooled(std::string textureText, SDL_Color textColor) {
+    //Blended text comes out 32-bit ARGB, which streaming textures take as is
+    SDL_Surface* textSurface = TTF_RenderText_Blended(gFont, textureText.c_str(), textColor);
+    if (textSurface == NULL) {
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+        free();
+        return false;
+    }
+
+    //Keep the current texture if the new text still fits its bucket
+    int bucketWidth = 0, bucketHeight = 0;
+    if (mTexture != NULL && mPooled)
+        SDL_QueryTexture( mTexture, NULL, NULL, &bucketWidth, &bucketHeight );
+    if (bucketWidth != nextPowerOfTwo( textSurface->w ) || bucketHeight != nextPowerOfTwo( textSurface->h )) {
+        free();
+        mTexture = gTexturePool.acquire( textSurface->format->format, textSurface->w, textSurface->h );
+        mPooled = mTexture != NULL;
+    }
+
+    if (mTexture != NULL) {
+        //Overwrite only the part we will draw
+        SDL_Rect region = { 0, 0, textSurface->w, textSurface->h };
+        SDL_UpdateTexture( mTexture, &region, textSurface->pixels, textSurface->pitch );
+        mWidth = textSurface->w;
+        mHeight = textSurface->h;
+    }
+    SDL_FreeSurface( textSurface );
+    return mTexture != NULL;
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    //Pooled textures hold the image in their top left corner
+    SDL_Rect image = { 0, 0, mWidth, mHeight };
+    if (clip == NULL && mPooled)
+        clip = &image;
+
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gCounterTexture;
+
+bool loadMedia() {
+    bool success = true;
+
+    //Load font
+    gFont = TTF_OpenFont("lazy.ttf", 28);
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    return success;
+}
+
+//Re-renders a frame counter BENCH_UPDATES times and returns microseconds per update
+double benchmark( bool pooled ) {
+    SDL_Color textColor = { 0, 0, 0, 0xFF };
+    char text[32];
+    LTexture counter;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < BENCH_UPDATES; i++) {
+        snprintf( text, sizeof( text ), "Frame: %d", i );
+        if (pooled)
+            counter.loadFromRenderedTextPooled( text, textColor );
+        else
+            counter.loadFromRenderedText( text, textColor );
+        SDL_RenderClear( gRenderer );
+        counter.render( 0, 0 );
+        SDL_RenderPresent( gRenderer );
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    counter.free();
+    return elapsed * 1000000.0 / SDL_GetPerformanceFrequency() / BENCH_UPDATES;
+}
+
+void close() {
+    gCounterTexture.free();
+    gTexturePool.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            double created = benchmark( false );
+            double pooled = benchmark( true );
+            LPoolStats stats = gTexturePool.getStats();
+            printf("Create/destroy: %.1f us per counter update\n", created);
+            printf("Texture pool:   %.1f us per counter update (%d created, %d reused)\n", pooled, stats.created, stats.reused);
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            SDL_Color textColor = { 0, 0, 0, 0xFF };
+            char text[32];
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Counter changes every frame and reuses its texture
+                snprintf( text, sizeof( text ), "Frame: %d", frame );
+                gCounterTexture.loadFromRenderedTextPooled( text, textColor );
+                gCounterTexture.render((SCREEN_WIDTH - gCounterTexture.getWidth())/2, (SCREEN_HEIGHT - gCounterTexture.getHeight())/2);
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+                ++frame;
+            }
+            LPoolStats stats = gTexturePool.getStats();
+            printf("Texture pool: %d created, %d reused over %d frames\n", stats.created, stats.reused, frame);
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,598 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int CHECK_ROUNDS = 10;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Pixel rows start on this boundary so SIMD kernels can use aligned loads
+const size_t PIXEL_ALIGNMENT = 64;
+
+//Smallest block, small SDL allocations are pooled too so no pixel buffer slips past --check
+const size_t POOL_MIN_SIZE = 64;
+
+//Buckets double from POOL_MIN_SIZE, so the largest holds 512 MB
+const int POOL_BUCKETS = 24;
+
+//Blocks the pool tracks, SDL keeps a few thousand small ones alive, allocations past this go to the heap
+const int MAX_POOL_BLOCKS = 65536;
+
+//Idle bytes the pool keeps for reuse, blocks released past this go back to the heap
+const size_t POOL_IDLE_LIMIT = 64 * 1024 * 1024;
+
+//Format intermediate surfaces are converted to before upload
+const Uint32 SURFACE_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+//Pool counters
+struct LPoolStats {
+    //Blocks taken from the heap
+    int heapAllocations;
+
+    //Requests served by a recycled block
+    int reuses;
+
+    //Blocks handed out and not yet released
+    int outstanding;
+
+    //Requests the pool could not serve, SDL's go to the heap instead
+    int fallbackAllocations;
+
+    //Bytes held by the pool
+    size_t pooledBytes;
+
+    //Blocks given back to the heap by the idle limit or trim()
+    int returnedBlocks;
+};
+
+//Aligned pixel buffers recycled by power of two size
+class LPixelPool {
+    public:
+        //Initializes internal variables
+        LPixelPool();
+
+        //Gets a 64-byte aligned buffer of at least size bytes, NULL if too big or the pool is full
+        void* allocate( size_t size );
+
+        //Returns a buffer, false if it did not come from the pool
+        bool release( void* pixels );
+
+        //Gets usable size of a pooled buffer, 0 if not ours
+        size_t getCapacity( void* pixels );
+
+        //Creates a surface over a pooled buffer
+        SDL_Surface* createSurface( int width, int height, Uint32 format );
+
+        //Frees a surface from createSurface() and returns its buffer
+        void freeSurface( SDL_Surface* surface );
+
+        //Gives every idle block back to the heap
+        void trim();
+
+        //Gets counters
+        LPoolStats getStats();
+
+    private:
+        //Finds the bucket of a pooled buffer, -1 if not ours
+        int findBucket( void* pixels );
+
+        //Frees a block that is not handed out, call with the lock held
+        void returnBlock( void* pixels, int bucket );
+
+        //Bucket of every block the pool holds, so frees look up instead of scanning
+        std::unordered_map<void*, int> mBlockBuckets;
+
+        //Released blocks of each bucket, ready for reuse
+        std::vector<void*> mIdleBlocks[ POOL_BUCKETS ];
+        size_t mIdleBytes;
+
+        //SDL may allocate from other threads
+        SDL_SpinLock mLock;
+
+        LPoolStats mStats;
+};
+
+LPixelPool::LPixelPool() {
+    //Sized up front so lookups never rehash under the lock
+    //Map nodes and idle lists still allocate, through operator new which the SDL hooks do not see
+    mBlockBuckets.reserve( MAX_POOL_BLOCKS );
+    mIdleBytes = 0;
+    mLock = 0;
+    mStats.heapAllocations = 0;
+    mStats.reuses = 0;
+    mStats.outstanding = 0;
+    mStats.fallbackAllocations = 0;
+    mStats.pooledBytes = 0;
+    mStats.returnedBlocks = 0;
+}
+
+void* LPixelPool::allocate( size_t size ) {
+    //Smallest bucket that fits
+    int bucket = 0;
+    while (bucket < POOL_BUCKETS && ( POOL_MIN_SIZE << bucket ) < size)
+        bucket++;
+    void* pixels = NULL;
+    SDL_AtomicLock( &mLock );
+
+    //Recycle an idle block of that bucket
+    if (bucket < POOL_BUCKETS && !mIdleBlocks[ bucket ].empty()) {
+        pixels = mIdleBlocks[ bucket ].back();
+        mIdleBlocks[ bucket ].pop_back();
+        mIdleBytes -= POOL_MIN_SIZE << bucket;
+        mStats.reuses++;
+    }
+
+    //Otherwise grow the pool
+    else if (bucket < POOL_BUCKETS && (int) mBlockBuckets.size() < MAX_POOL_BLOCKS) {
+        size_t capacity = POOL_MIN_SIZE << bucket;
+        pixels = aligned_alloc( PIXEL_ALIGNMENT, capacity );
+        if (pixels != NULL) {
+            mBlockBuckets[ pixels ] = bucket;
+            mStats.heapAllocations++;
+            mStats.pooledBytes += capacity;
+        }
+    }
+
+    if (pixels != NULL)
+        mStats.outstanding++;
+    else
+        mStats.fallbackAllocations++;
+    SDL_AtomicUnlock( &mLock );
+    return pixels;
+}
+
+int LPixelPool::findBucket( void* pixels ) {
+    std::unordered_map<void*, int>::iterator found = mBlockBuckets.find( pixels );
+    return found != mBlockBuckets.end() ? found->second : -1;
+}
+
+void LPixelPool::returnBlock( void* pixels, int bucket ) {
+    mBlockBuckets.erase( pixels );
+    ::free( pixels );
+    mStats.pooledBytes -= POOL_MIN_SIZE << bucket;
+    mStats.returnedBlocks++;
+}
+
+bool LPixelPool::release( void* pixels ) {
+    SDL_AtomicLock( &mLock );
+    int bucket = findBucket( pixels );
+    if (bucket >= 0) {
+        //Keep blocks for reuse only up to the idle limit, so a loading peak does not stay resident
+        size_t capacity = POOL_MIN_SIZE << bucket;
+        if (mIdleBytes + capacity > POOL_IDLE_LIMIT)
+            returnBlock( pixels, bucket );
+        else {
+            mIdleBlocks[ bucket ].push_back( pixels );
+            mIdleBytes += capacity;
+        }
+        mStats.outstanding--;
+    }
+    SDL_AtomicUnlock( &mLock );
+    return bucket >= 0;
+}
+
+size_t LPixelPool::getCapacity( void* pixels ) {
+    SDL_AtomicLock( &mLock );
+    int bucket = findBucket( pixels );
+    size_t capacity = bucket >= 0 ? POOL_MIN_SIZE << bucket : 0;
+    SDL_AtomicUnlock( &mLock );
+    return capacity;
+}
+
+void LPixelPool::trim() {
+    SDL_AtomicLock( &mLock );
+    for (int bucket = 0; bucket < POOL_BUCKETS; bucket++) {
+        for (size_t i = 0; i < mIdleBlocks[ bucket ].size(); i++)
+            returnBlock( mIdleBlocks[ bucket ][i], bucket );
+        mIdleBlocks[ bucket ].clear();
+    }
+    mIdleBytes = 0;
+    SDL_AtomicUnlock( &mLock );
+}
+
+SDL_Surface* LPixelPool::createSurface( int width, int height, Uint32 format ) {
+    //Pad rows so every row starts aligned, not just the first
+    int pitch = width * SDL_BYTESPERPIXEL( format );
+    pitch = ( pitch + PIXEL_ALIGNMENT - 1 ) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+
+    void* pixels = allocate( (size_t) pitch * height );
+    if (pixels == NULL) {
+        printf("Pixel pool can't hold a %dx%d surface!\n", width, height);
+        return NULL;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom( pixels, width, height, SDL_BITSPERPIXEL( format ), pitch, format );
+    if (surface == NULL) {
+        printf("Unable to create pooled surface! SDL Error: %s\n", SDL_GetError());
+        release( pixels );
+    }
+    return surface;
+}
+
+void LPixelPool::freeSurface( SDL_Surface* surface ) {
+    //Surface was made over our buffer so SDL leaves the pixels alone
+    void* pixels = surface->pixels;
+    SDL_FreeSurface( surface );
+    release( pixels );
+}
+
+LPoolStats LPixelPool::getStats() {
+    SDL_AtomicLock( &mLock );
+    LPoolStats stats = mStats;
+    SDL_AtomicUnlock( &mLock );
+    return stats;
+}
+
+LPixelPool gPixelPool;
+
+//SDL memory functions that send every allocation to gPixelPool
+//This also covers surfaces SDL_image, SDL_ttf and texture uploads create internally
+void* SDLCALL pooledMalloc( size_t size ) {
+    void* mem = gPixelPool.allocate( size );
+    return mem != NULL ? mem : malloc( size );
+}
+
+void* SDLCALL pooledCalloc( size_t count, size_t size ) {
+    size_t total = count * size;
+    void* mem = count != 0 && total / count != size ? NULL : gPixelPool.allocate( total );
+    if (mem == NULL)
+        return calloc( count, size );
+    memset( mem, 0, total );
+    return mem;
+}
+
+void* SDLCALL pooledRealloc( void* mem, size_t size ) {
+    if (mem == NULL)
+        return pooledMalloc( size );
+
+    //Heap blocks stay on the heap
+    size_t capacity = gPixelPool.getCapacity( mem );
+    if (capacity == 0)
+        return realloc( mem, size );
+    if (size <= capacity)
+        return mem;
+
+    //Move to a bigger pooled block
+    void* grown = pooledMalloc( size );
+    if (grown != NULL) {
+        memcpy( grown, mem, capacity );
+        gPixelPool.release( mem );
+    }
+    return grown;
+}
+
+void SDLCALL pooledFree( void* mem ) {
+    if (mem != NULL && !gPixelPool.release( mem ))
+        free( mem );
+}
+
+//Copies a surface into a pooled surface in SURFACE_FORMAT, turning color key into alpha
+SDL_Surface* convertToPooled( SDL_Surface* source ) {
+    SDL_Surface* converted = gPixelPool.createSurface( source->w, source->h, SURFACE_FORMAT );
+    if (converted != NULL) {
+        //Keyed pixels are skipped by the blit and stay transparent
+        SDL_FillRect( converted, NULL, 0 );
+        SDL_SetSurfaceBlendMode( source, SDL_BLENDMODE_NONE );
+        SDL_BlitSurface( source, NULL, converted, NULL );
+    }
+    return converted;
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Creates image from font string
+        bool loadFromRenderedText(std::string textureText, SDL_Color textColor);
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Uploads a decoded surface through a pooled intermediate
+        bool loadFromSurface( SDL_Surface* surface );
+
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromSurface( SDL_Surface* surface ) {
+    //Upload takes a surface already in the texture's format, so SDL converts nothing
+    SDL_Surface* converted = convertToPooled( surface );
+    if (converted == NULL)
+        return false;
+
+    mTexture = SDL_CreateTextureFromSurface( gRenderer, converted );
+    if (mTexture == NULL)
+        printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+    else {
+        //Store image dimesions
+        mWidth = converted->w;
+        mHeight = converted->h;
+    }
+    gPixelPool.freeSurface( converted );
+    return mTexture != NULL;
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    //Decoded pixels come from the pool through the SDL memory functions
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        loadFromSurface( loadedSurface );
+
+        //get rid of old surface, its pixels go back to the pool
+        SDL_FreeSurface(loadedSurface);
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    SDL_Surface* textSurface = TTF_RenderText_Solid(gFont, textureText.c_str(), textColor);
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        if (!loadFromSurface( textSurface ))
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        SDL_FreeSurface(textSurface);
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gBackgroundTexture;
+LTexture gDotsTexture;
+LTexture gTextTexture;
+
+//Loads the lesson's textures into the given objects
+bool loadTextures( LTexture* background, LTexture* dots, LTexture* text ) {
+    bool success = true;
+
+    if (!background->loadFromFile("texture.png")) {
+        printf("Failed to load background texture!\n");
+        success = false;
+    }
+
+    if (!dots->loadFromFile("dots.png")) {
+        printf("Failed to load dots texture!\n");
+        success = false;
+    }
+
+    SDL_Color textColor = {0, 0, 0};
+    if (!text->loadFromRenderedText("The quick brown fox jumps over the lazy dog", textColor)) {
+        printf("Error loading the text!\n");
+        success = false;
+    }
+    return success;
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    //Load font
+    gFont = TTF_OpenFont("lazy.ttf", 28);
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    else
+        success = loadTextures( &gBackgroundTexture, &gDotsTexture, &gTextTexture );
+    return success;
+}
+
+//Reloads everything repeatedly and checks the pool stops growing after the first round
+bool checkSteadyState() {
+    int warmAllocations = 0;
+    int warmFallbacks = 0;
+    for (int round = 0; round < CHECK_ROUNDS; round++) {
+        LTexture background, dots, text;
+        if (!loadTextures( &background, &dots, &text ))
+            return false;
+        background.free();
+        dots.free();
+        text.free();
+
+        if (round == 0) {
+            warmAllocations = gPixelPool.getStats().heapAllocations;
+            warmFallbacks = gPixelPool.getStats().fallbackAllocations;
+        }
+    }
+
+    //Unpooled heap allocations count too, they are what the pool is meant to remove
+    LPoolStats stats = gPixelPool.getStats();
+    int steadyAllocations = stats.heapAllocations - warmAllocations;
+    int steadyFallbacks = stats.fallbackAllocations - warmFallbacks;
+    printf("Pixel pool: %d heap allocations warming up, %d over %d more rounds, %d unpooled, %d reuses, %.1f MB pooled\n",
+        warmAllocations, steadyAllocations, CHECK_ROUNDS - 1, steadyFallbacks, stats.reuses, stats.pooledBytes / 1048576.0);
+    if (steadyAllocations != 0 || steadyFallbacks != 0) {
+        printf("FAIL: steady state loading allocated memory from the heap\n");
+        return false;
+    }
+    printf("PASS: steady state loading reused pooled pixel memory\n");
+    return true;
+}
+
+void close() {
+    gBackgroundTexture.free();
+    gDotsTexture.free();
+    gTextTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    //Must happen before SDL allocates anything
+    SDL_SetMemoryFunctions( pooledMalloc, pooledCalloc, pooledRealloc, pooledFree );
+
+    bool check = argc > 1 && strcmp( args[1], "--check" ) == 0;
+    bool passed = true;
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (check) {
+            passed = checkSteadyState();
+        }
+        else {
+            //Nothing reloads from here on, so what loading left idle goes back to the heap
+            gPixelPool.trim();
+
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the textures
+                gBackgroundTexture.render( 0, 0 );
+                gDotsTexture.render( 0, 0 );
+                gTextTexture.render((SCREEN_WIDTH - gTextTexture.getWidth())/2, (SCREEN_HEIGHT - gTextTexture.getHeight())/2);
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,665 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <new>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int WALKING_ANIMATION_FRAMES = 4;
+const int TOTAL_WALKERS = 20;
+const int FIRST_GLYPH = 32;
+const int TOTAL_GLYPHS = 95;
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+const int WARMUP_FRAMES = 60;
+const int CHECK_FRAMES = 600;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Heap allocations made in the process, see below for what each platform counts
+SDL_atomic_t gHeapAllocations;
+
+#if defined(__GLIBC__)
+//glibc's allocator under its internal names
+extern "C" void* __libc_malloc( size_t size );
+extern "C" void* __libc_calloc( size_t count, size_t size );
+extern "C" void* __libc_realloc( void* mem, size_t size );
+extern "C" void __libc_free( void* mem );
+
+//Defining malloc here replaces it for every library, so libpng, FreeType and the driver are counted too
+//This can run before SDL is loaded, so the counter is bumped without calling into SDL
+extern "C" void* malloc( size_t size ) {
+    __atomic_add_fetch( &gHeapAllocations.value, 1, __ATOMIC_RELAXED );
+    return __libc_malloc( size );
+}
+
+extern "C" void* calloc( size_t count, size_t size ) {
+    __atomic_add_fetch( &gHeapAllocations.value, 1, __ATOMIC_RELAXED );
+    return __libc_calloc( count, size );
+}
+
+extern "C" void* realloc( void* mem, size_t size ) {
+    __atomic_add_fetch( &gHeapAllocations.value, 1, __ATOMIC_RELAXED );
+    return __libc_realloc( mem, size );
+}
+
+extern "C" void free( void* mem ) {
+    __libc_free( mem );
+}
+
+//operator new and SDL_malloc end up in malloc above
+const char* ALLOCATIONS_COUNTED = "every malloc in the process";
+#else
+//Elsewhere only allocations through operator new and SDL_malloc are seen
+//Libraries calling malloc themselves, like libpng, FreeType and the driver, are not
+const char* ALLOCATIONS_COUNTED = "operator new and SDL_malloc only, library mallocs are not counted";
+
+void* operator new( size_t size ) {
+    SDL_AtomicIncRef( &gHeapAllocations );
+    void* mem = malloc( size > 0 ? size : 1 );
+    if (mem == NULL)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void operator delete( void* mem ) noexcept {
+    free( mem );
+}
+
+void operator delete( void* mem, size_t size ) noexcept {
+    free( mem );
+}
+
+//SDL memory functions that count allocations, this also covers SDL_image and SDL_ttf
+void* SDLCALL countingMalloc( size_t size ) {
+    SDL_AtomicIncRef( &gHeapAllocations );
+    return malloc( size );
+}
+
+void* SDLCALL countingCalloc( size_t count, size_t size ) {
+    SDL_AtomicIncRef( &gHeapAllocations );
+    return calloc( count, size );
+}
+
+void* SDLCALL countingRealloc( void* mem, size_t size ) {
+    SDL_AtomicIncRef( &gHeapAllocations );
+    return realloc( mem, size );
+}
+
+void SDLCALL countingFree( void* mem ) {
+    free( mem );
+}
+#endif
+
+//Checks that frames stop allocating once warmed up
+class LAllocTracker {
+    public:
+        //Initializes internal variables
+        LAllocTracker();
+
+        //Frames allowed to allocate before the check applies
+        void setWarmupFrames( int frames );
+
+        //Marks the start of a frame
+        void beginFrame();
+
+        //Marks the end of a frame, returns allocations made during it
+        int endFrame();
+
+        //Checks if every frame after warm up was allocation free
+        bool isClean();
+
+        //Gets counters
+        int getFrames();
+        int getDirtyFrames();
+        int getSteadyAllocations();
+
+    private:
+        //Allocation count when the frame began
+        int mFrameStart;
+
+        int mFrames;
+        int mWarmupFrames;
+
+        //Frames after warm up that allocated and how much
+        int mDirtyFrames;
+        int mSteadyAllocations;
+};
+
+LAllocTracker::LAllocTracker() {
+    mFrameStart = 0;
+    mFrames = 0;
+    mWarmupFrames = 0;
+    mDirtyFrames = 0;
+    mSteadyAllocations = 0;
+}
+
+void LAllocTracker::setWarmupFrames( int frames ) {
+    mWarmupFrames = frames;
+}
+
+void LAllocTracker::beginFrame() {
+    mFrameStart = SDL_AtomicGet( &gHeapAllocations );
+}
+
+int LAllocTracker::endFrame() {
+    int allocations = SDL_AtomicGet( &gHeapAllocations ) - mFrameStart;
+    if (mFrames >= mWarmupFrames && allocations > 0) {
+        mDirtyFrames++;
+        mSteadyAllocations += allocations;
+    }
+    mFrames++;
+    return allocations;
+}
+
+bool LAllocTracker::isClean() {
+    return mDirtyFrames == 0;
+}
+
+int LAllocTracker::getFrames() {
+    return mFrames;
+}
+
+int LAllocTracker::getDirtyFrames() {
+    return mDirtyFrames;
+}
+
+int LAllocTracker::getSteadyAllocations() {
+    return mSteadyAllocations;
+}
+
+//Linear allocator for data that only lives for one frame
+class LFrameArena {
+    public:
+        //Initializes internal variables
+        LFrameArena();
+
+        //Deallocates memory
+        ~LFrameArena();
+
+        //Allocates the backing buffer, the only heap allocation the arena makes
+        bool init( size_t capacity );
+
+        //Gets size bytes aligned to align, NULL when the arena is full
+        void* allocate( size_t size, size_t align = 16 );
+
+        //Formats a string into the arena
+        char* format( const char* fmt, ... );
+
+        //Releases everything allocated this frame
+        void reset();
+
+        //Deallocates the backing buffer
+        void free();
+
+        //Gets usage
+        size_t getUsed();
+        size_t getHighWater();
+        size_t getCapacity();
+        int getOverflows();
+
+    private:
+        char* mBuffer;
+        size_t mCapacity;
+        size_t mUsed;
+
+        //Most used in any frame, for sizing the arena
+        size_t mHighWater;
+
+        //Requests that did not fit
+        int mOverflows;
+};
+
+LFrameArena::LFrameArena() {
+    mBuffer = NULL;
+    mCapacity = 0;
+    mUsed = 0;
+    mHighWater = 0;
+    mOverflows = 0;
+}
+
+LFrameArena::~LFrameArena() {
+    free();
+}
+
+bool LFrameArena::init( size_t capacity ) {
+    free();
+    mBuffer = (char*) malloc( capacity );
+    if (mBuffer == NULL) {
+        printf("Unable to allocate %u byte frame arena!\n", (unsigned) capacity);
+        return false;
+    }
+    mCapacity = capacity;
+    return true;
+}
+
+void* LFrameArena::allocate( size_t size, size_t align ) {
+    size_t start = ( mUsed + align - 1 ) & ~( align - 1 );
+    if (start + size > mCapacity) {
+        mOverflows++;
+        return NULL;
+    }
+    mUsed = start + size;
+    return mBuffer + start;
+}
+
+char* LFrameArena::format( const char* fmt, ... ) {
+    va_list args;
+
+    //Measure first so the string is allocated exactly once
+    va_start( args, fmt );
+    int length = SDL_vsnprintf( NULL, 0, fmt, args );
+    va_end( args );
+    if (length < 0)
+        return NULL;
+
+    char* text = (char*) allocate( length + 1, 1 );
+    if (text != NULL) {
+        va_start( args, fmt );
+        SDL_vsnprintf( text, length + 1, fmt, args );
+        va_end( args );
+    }
+    return text;
+}
+
+void LFrameArena::reset() {
+    if (mUsed > mHighWater)
+        mHighWater = mUsed;
+    mUsed = 0;
+}
+
+void LFrameArena::free() {
+    if (mBuffer != NULL) {
+        ::free( mBuffer );
+        mBuffer = NULL;
+        mCapacity = 0;
+        mUsed = 0;
+    }
+}
+
+size_t LFrameArena::getUsed() {
+    return mUsed;
+}
+
+size_t LFrameArena::getHighWater() {
+    return mHighWater > mUsed ? mHighWater : mUsed;
+}
+
+size_t LFrameArena::getCapacity() {
+    return mCapacity;
+}
+
+int LFrameArena::getOverflows() {
+    return mOverflows;
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Creates image from font string
+        bool loadFromRenderedText(std::string textureText, SDL_Color textColor);
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+bool LTexture::loadFromRenderedText(std::string textureText, SDL_Color textColor) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    SDL_Surface* textSurface = TTF_RenderText_Solid(gFont, textureText.c_str(), textColor);
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        //Create texture from surface pixels
+        mTexture = SDL_CreateTextureFromSurface(gRenderer, textSurface);
+        if (mTexture == NULL)
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        else {
+            //Get Image Dimensions
+            mWidth = textSurface->w;
+            mHeight = textSurface->h;
+        }
+        SDL_FreeSurface(textSurface);
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+//Text drawn from pre-rendered glyphs, so changing text allocates nothing
+class LGlyphText {
+    public:
+        //Renders every printable ASCII glyph of gFont
+        bool load( SDL_Color textColor );
+
+        //Deallocates glyphs
+        void free();
+
+        //Draws text at a given point
+        void render( int x, int y, const char* text );
+
+    private:
+        LTexture mGlyphs[ TOTAL_GLYPHS ];
+};
+
+bool LGlyphText::load( SDL_Color textColor ) {
+    bool success = true;
+    for (int i = 0; i < TOTAL_GLYPHS; i++) {
+        if (!mGlyphs[i].loadFromRenderedText( std::string( 1, (char) ( FIRST_GLYPH + i ) ), textColor ))
+            success = false;
+    }
+    return success;
+}
+
+void LGlyphText::free() {
+    for (int i = 0; i < TOTAL_GLYPHS; i++)
+        mGlyphs[i].free();
+}
+
+void LGlyphText::render( int x, int y, const char* text ) {
+    for (const char* c = text; *c != '\0'; c++) {
+        int glyph = *c - FIRST_GLYPH;
+        if (glyph < 0 || glyph >= TOTAL_GLYPHS)
+            glyph = '?' - FIRST_GLYPH;
+        mGlyphs[glyph].render( x, y );
+        x += mGlyphs[glyph].getWidth();
+    }
+}
+
+//Walking animation
+SDL_Rect gSpriteClips[ WALKING_ANIMATION_FRAMES ];
+LTexture gSpriteSheetTexture;
+LGlyphText gText;
+
+LAllocTracker gAllocTracker;
+LFrameArena gFrameArena;
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gSpriteSheetTexture.loadFromFile("foo.png")) {
+        printf("Failed to load walking animation texture!\n");
+        success = false;
+    }
+    else {
+        //Clips live for the whole program so they are plain globals, not heap blocks
+        for (int i = 0; i < WALKING_ANIMATION_FRAMES; i++) {
+            gSpriteClips[i].x = i * 64;
+            gSpriteClips[i].y = 0;
+            gSpriteClips[i].w = 64;
+            gSpriteClips[i].h = 205;
+        }
+    }
+
+    //Load font
+    gFont = TTF_OpenFont("lazy.ttf", 20);
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    else {
+        SDL_Color textColor = {0, 0, 0};
+        if (!gText.load( textColor )) {
+            printf("Error loading the glyphs!\n");
+            success = false;
+        }
+    }
+
+    //Per frame data comes from here from now on
+    if (!gFrameArena.init( FRAME_ARENA_SIZE ))
+        success = false;
+    return success;
+}
+
+//Draws one frame, everything transient comes from gFrameArena
+void renderFrame( int frame, int lastAllocations ) {
+    //Initialize renderer color
+    SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+    //Clear Screen
+    SDL_RenderClear( gRenderer );
+
+    //Walker positions for this frame, two rows marching right and wrapping around
+    SDL_Point* positions = (SDL_Point*) gFrameArena.allocate( TOTAL_WALKERS * sizeof(SDL_Point) );
+    if (positions != NULL) {
+        int perRow = TOTAL_WALKERS / 2;
+        int spacing = ( SCREEN_WIDTH + 64 ) / perRow;
+        for (int i = 0; i < TOTAL_WALKERS; i++) {
+            positions[i].x = ( ( i % perRow ) * spacing + frame * 2 ) % ( SCREEN_WIDTH + 64 ) - 64;
+            positions[i].y = i < perRow ? 40 : 260;
+        }
+        for (int i = 0; i < TOTAL_WALKERS; i++) {
+            SDL_Rect* currentClip = &gSpriteClips[ ( frame / 8 + i ) % WALKING_ANIMATION_FRAMES ];
+            gSpriteSheetTexture.render( positions[i].x, positions[i].y, currentClip );
+        }
+    }
+
+    //Status text changes every frame without rendering new textures
+    char* status = gFrameArena.format( "Frame %d  allocations %d  arena %u/%u bytes",
+        frame, lastAllocations, (unsigned) gFrameArena.getHighWater(), (unsigned) gFrameArena.getCapacity() );
+    if (status != NULL)
+        gText.render( 10, 10, status );
+
+    //Update screen
+    SDL_RenderPresent( gRenderer );
+}
+
+void printStats() {
+    printf("Frame %d: %d frames allocated after warm up (%d allocations), arena high water %u of %u bytes, %d overflows\n",
+        gAllocTracker.getFrames(), gAllocTracker.getDirtyFrames(), gAllocTracker.getSteadyAllocations(),
+        (unsigned) gFrameArena.getHighWater(), (unsigned) gFrameArena.getCapacity(), gFrameArena.getOverflows());
+}
+
+void close() {
+    gSpriteSheetTexture.free();
+    gText.free();
+    gFrameArena.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, checks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+#if !defined(__GLIBC__)
+    //Must happen before SDL allocates anything
+    SDL_SetMemoryFunctions( countingMalloc, countingCalloc, countingRealloc, countingFree );
+#endif
+
+    bool check = argc > 1 && strcmp( args[1], "--check" ) == 0;
+    bool passed = true;
+    if (!init( !check )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            int lastAllocations = 0;
+            gAllocTracker.setWarmupFrames( WARMUP_FRAMES );
+            //Main Loop
+            while (!quit) {
+                gAllocTracker.beginFrame();
+
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //SDL_Quit event is pressing X
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                }
+                renderFrame( frame, lastAllocations );
+
+                //Nothing allocated this frame outlives it
+                gFrameArena.reset();
+                lastAllocations = gAllocTracker.endFrame();
+
+                ++frame;
+                if (frame % 60 == 0)
+                    printStats();
+                if (check && frame == CHECK_FRAMES)
+                    quit = true;
+            }
+
+            if (check) {
+                passed = gAllocTracker.isClean() && gFrameArena.getOverflows() == 0;
+                printf("%s: %d frames after a %d frame warm up made %d heap allocations (counted: %s)\n",
+                    passed ? "PASS" : "FAIL", CHECK_FRAMES - WARMUP_FRAMES, WARMUP_FRAMES, gAllocTracker.getSteadyAllocations(), ALLOCATIONS_COUNTED);
+            }
+        }
+    }
+    close();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,750 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int BUTTON_HEIGHT = 200;
+const int BUTTON_WIDTH = 300;
+const int TOTAL_BUTTONS = 4;
+const char* REPLAY_FILE = "replay.bin";
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Replay file layout, all values little endian
+//Header: magic, version, frame count, event count, final frame hash
+//Then one record per event: frame, type, x, y, code
+const Uint32 REPLAY_MAGIC = 0x524C4453; //"SDLR"
+const Uint32 REPLAY_VERSION = 1;
+const int REPLAY_HEADER_SIZE = 24;
+const int REPLAY_RECORD_SIZE = 20;
+
+enum LButtonSprite {
+    BUTTON_SPRITE_MOUSE_OUT,
+    BUTTON_SPRITE_MOUSE_OVER_MOTION,
+    BUTTON_SPRITE_MOUSE_DOWN,
+    BUTTON_SPRITE_MOUSE_UP,
+    BUTTON_SPRITE_TOTAL
+};
+
+//Input event reduced to the fields the lesson reacts to
+struct LRecordedEvent {
+    //Frame the event was polled on
+    Uint32 frame;
+
+    Uint32 type;
+
+    //Mouse position
+    Sint32 x;
+    Sint32 y;
+
+    //Mouse button or key symbol
+    Uint32 code;
+};
+
+//Writes polled events to a replay file
+class LInputRecorder {
+    public:
+        //Initializes internal variables
+        LInputRecorder();
+
+        //Closes file
+        ~LInputRecorder();
+
+        //Starts a replay file, leaving room for the header
+        bool open( std::string path );
+
+        //Appends the event if it is input the lesson uses
+        void record( int frame, SDL_Event* e );
+
+        //Writes the header and closes the file
+        bool close( int frames, Uint64 frameHash );
+
+    private:
+        SDL_RWops* mFile;
+        int mEvents;
+};
+
+//Reads a replay file and pushes its events back into the queue
+class LInputPlayer {
+    public:
+        //Initializes internal variables
+        LInputPlayer();
+
+        //Reads the whole replay file
+        bool load( std::string path );
+
+        //Pushes every event recorded on this frame
+        void inject( int frame );
+
+        //Checks if every recorded frame has been played
+        bool isFinished( int frame );
+
+        //Gets recorded totals
+        int getFrames();
+        Uint64 getFrameHash();
+
+    private:
+        std::vector<LRecordedEvent> mEvents;
+
+        //Next event to push
+        size_t mNext;
+
+        int mFrames;
+        Uint64 mFrameHash;
+};
+
+//Hashes every rendered frame into one value
+class LFrameHasher {
+    public:
+        //Initializes internal variables
+        LFrameHasher();
+
+        //Deallocates pixel buffer
+        ~LFrameHasher();
+
+        //Allocates room for one frame
+        bool init( int width, int height );
+
+        //Hashes the current render target, call before presenting
+        void addFrame();
+
+        //Gets hash of all frames so far
+        Uint64 getHash();
+
+    private:
+        Uint32* mPixels;
+        int mWidth;
+        int mHeight;
+        Uint64 mHash;
+};
+
+LInputRecorder::LInputRecorder() {
+    mFile = NULL;
+    mEvents = 0;
+}
+
+LInputRecorder::~LInputRecorder() {
+    if (mFile != NULL)
+        SDL_RWclose( mFile );
+}
+
+bool LInputRecorder::open( std::string path ) {
+    mFile = SDL_RWFromFile( path.c_str(), "wb" );
+    if (mFile == NULL) {
+        printf("Unable to create %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+
+    //Placeholder header, rewritten by close()
+    SDL_WriteLE32( mFile, 0 );
+    SDL_WriteLE32( mFile, REPLAY_VERSION );
+    SDL_WriteLE32( mFile, 0 );
+    SDL_WriteLE32( mFile, 0 );
+    SDL_WriteLE64( mFile, 0 );
+    mEvents = 0;
+    return true;
+}
+
+void LInputRecorder::record( int frame, SDL_Event* e ) {
+    LRecordedEvent recorded;
+    recorded.frame = frame;
+    recorded.type = e->type;
+    recorded.x = 0;
+    recorded.y = 0;
+    recorded.code = 0;
+
+    switch( e->type ) {
+        case SDL_MOUSEMOTION:
+        recorded.x = e->motion.x;
+        recorded.y = e->motion.y;
+        recorded.code = e->motion.state;
+        break;
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+        recorded.x = e->button.x;
+        recorded.y = e->button.y;
+        recorded.code = e->button.button;
+        break;
+
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        recorded.code = e->key.keysym.sym;
+        break;
+
+        case SDL_QUIT:
+        break;
+
+        //Window and other events do not change what gets drawn
+        default:
+        return;
+    }
+
+    SDL_WriteLE32( mFile, recorded.frame );
+    SDL_WriteLE32( mFile, recorded.type );
+    SDL_WriteLE32( mFile, recorded.x );
+    SDL_WriteLE32( mFile, recorded.y );
+    SDL_WriteLE32( mFile, recorded.code );
+    mEvents++;
+}
+
+bool LInputRecorder::close( int frames, Uint64 frameHash ) {
+    if (mFile == NULL)
+        return false;
+
+    SDL_RWseek( mFile, 0, RW_SEEK_SET );
+    SDL_WriteLE32( mFile, REPLAY_MAGIC );
+    SDL_WriteLE32( mFile, REPLAY_VERSION );
+    SDL_WriteLE32( mFile, frames );
+    SDL_WriteLE32( mFile, mEvents );
+    SDL_WriteLE64( mFile, frameHash );
+    bool success = SDL_RWclose( mFile ) == 0;
+    mFile = NULL;
+
+    printf("Recorded %d events over %d frames, frame hash %016llx\n", mEvents, frames, (unsigned long long) frameHash);
+    return success;
+}
+
+LInputPlayer::LInputPlayer() {
+    mNext = 0;
+    mFrames = 0;
+    mFrameHash = 0;
+}
+
+bool LInputPlayer::load( std::string path ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL) {
+        printf("Unable to open %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+
+    bool success = true;
+    Sint64 size = SDL_RWsize( file );
+    if (size < REPLAY_HEADER_SIZE || SDL_ReadLE32( file ) != REPLAY_MAGIC || SDL_ReadLE32( file ) != REPLAY_VERSION) {
+        printf("%s is not a replay file!\n", path.c_str());
+        success = false;
+    }
+    else {
+        mFrames = SDL_ReadLE32( file );
+        int count = SDL_ReadLE32( file );
+        mFrameHash = SDL_ReadLE64( file );
+
+        //Counts come from the file, so they must match what it actually holds
+        if (mFrames < 0 || count < 0 || count > ( size - REPLAY_HEADER_SIZE ) / REPLAY_RECORD_SIZE) {
+            printf("%s is truncated or corrupt!\n", path.c_str());
+            SDL_RWclose( file );
+            return false;
+        }
+
+        mEvents.resize( count );
+        for (int i = 0; i < count; i++) {
+            mEvents[i].frame = SDL_ReadLE32( file );
+            mEvents[i].type = SDL_ReadLE32( file );
+            mEvents[i].x = SDL_ReadLE32( file );
+            mEvents[i].y = SDL_ReadLE32( file );
+            mEvents[i].code = SDL_ReadLE32( file );
+        }
+        mNext = 0;
+        if (SDL_RWtell( file ) != REPLAY_HEADER_SIZE + (Sint64) count * REPLAY_RECORD_SIZE) {
+            printf("Unable to read %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+            mEvents.clear();
+            success = false;
+        }
+    }
+    SDL_RWclose( file );
+    return success;
+}
+
+void LInputPlayer::inject( int frame ) {
+    while (mNext < mEvents.size() && mEvents[mNext].frame == (Uint32) frame) {
+        LRecordedEvent* recorded = &mEvents[mNext];
+        SDL_Event e;
+        memset( &e, 0, sizeof(e) );
+        e.type = recorded->type;
+
+        switch( recorded->type ) {
+            case SDL_MOUSEMOTION:
+            e.motion.x = recorded->x;
+            e.motion.y = recorded->y;
+            e.motion.state = recorded->code;
+            break;
+
+            case SDL_MOUSEBUTTONDOWN:
+            case SDL_MOUSEBUTTONUP:
+            e.button.x = recorded->x;
+            e.button.y = recorded->y;
+            e.button.button = recorded->code;
+            e.button.state = recorded->type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+            break;
+
+            case SDL_KEYDOWN:
+            case SDL_KEYUP:
+            e.key.keysym.sym = recorded->code;
+            e.key.keysym.scancode = SDL_GetScancodeFromKey( recorded->code );
+            e.key.state = recorded->type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+            break;
+        }
+        SDL_PushEvent( &e );
+        mNext++;
+    }
+}
+
+bool LInputPlayer::isFinished( int frame ) {
+    return frame >= mFrames;
+}
+
+int LInputPlayer::getFrames() {
+    return mFrames;
+}
+
+Uint64 LInputPlayer::getFrameHash() {
+    return mFrameHash;
+}
+
+LFrameHasher::LFrameHasher() {
+    mPixels = NULL;
+    mWidth = 0;
+    mHeight = 0;
+    //FNV-1a offset basis
+    mHash = 14695981039346656037ULL;
+}
+
+LFrameHasher::~LFrameHasher() {
+    free( mPixels );
+}
+
+bool LFrameHasher::init( int width, int height ) {
+    mPixels = (Uint32*) malloc( width * height * sizeof(Uint32) );
+    mWidth = width;
+    mHeight = height;
+    return mPixels != NULL;
+}
+
+void LFrameHasher::addFrame() {
+    if (SDL_RenderReadPixels( gRenderer, NULL, SDL_PIXELFORMAT_ARGB8888, mPixels, mWidth * sizeof(Uint32) ) != 0) {
+        printf("Unable to read frame! SDL Error: %s\n", SDL_GetError());
+        return;
+    }
+
+    //FNV-1a over whole pixels, order matters so frames cannot swap unnoticed
+    for (int i = 0; i < mWidth * mHeight; i++) {
+        mHash ^= mPixels[i];
+        mHash *= 1099511628211ULL;
+    }
+}
+
+Uint64 LFrameHasher::getHash() {
+    return mHash;
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gButtonSpriteSheetTexture;
+LTexture gArrowTexture;
+SDL_Rect gSpriteClips[BUTTON_SPRITE_TOTAL];
+
+class LButton {
+    public:
+        //Initializes internal variables
+        LButton();
+
+        //Set top left position
+        void setPosition( int x, int y );
+
+        //Handles mouse event
+        void handleEvent( SDL_Event* e );
+
+        //Shows button sprite
+        void render();
+
+    private:
+        //Top left position
+        SDL_Point mPosition;
+
+        //Currently used global sprite
+        LButtonSprite mCurrentSprite;
+};
+
+LButton::LButton() {
+    mPosition.x = 0;
+    mPosition.y = 0;
+
+    mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
+}
+
+void LButton::setPosition(int x, int y) {
+    mPosition.x = x;
+    mPosition.y = y;
+}
+
+void LButton::handleEvent(SDL_Event* e) {
+    //If mouse event happend
+    if ( e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN || e->type == SDL_MOUSEBUTTONUP ) {
+        //Take position from the event, pushed events do not move SDL's mouse state
+        int x, y;
+        if (e->type == SDL_MOUSEMOTION) {
+            x = e->motion.x;
+            y = e->motion.y;
+        }
+        else {
+            x = e->button.x;
+            y = e->button.y;
+        }
+        bool inside = false;
+
+        //Check if mouse is inside button
+        if (x >= mPosition.x && x <= mPosition.x + BUTTON_WIDTH && y >= mPosition.y && y <= mPosition.y + BUTTON_HEIGHT)
+            inside = true;
+
+        //Mouse is outside button
+        if (!inside)
+            mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
+
+        //Mouse is inside button
+        else {
+            //Set mouse over sprite
+            switch( e->type ) {
+                case SDL_MOUSEMOTION:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_OVER_MOTION;
+                break;
+
+                case SDL_MOUSEBUTTONDOWN:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_DOWN;
+                break;
+
+                case SDL_MOUSEBUTTONUP:
+                mCurrentSprite = BUTTON_SPRITE_MOUSE_UP;
+                break;
+            }
+        }
+
+    }
+}
+
+void LButton::render() {
+    //Show current button sprite
+    gButtonSpriteSheetTexture.render( mPosition.x, mPosition.y, &gSpriteClips[ mCurrentSprite ] );
+}
+
+LButton gButtons[TOTAL_BUTTONS];
+
+void initSpriteClips() {
+    for (int i = 0; i < BUTTON_SPRITE_TOTAL; i++) {
+        gSpriteClips[i].x = 0;
+        gSpriteClips[i].y = i*200;
+        gSpriteClips[i].w = BUTTON_WIDTH;
+        gSpriteClips[i].h = BUTTON_HEIGHT;
+    }
+}
+
+void initButtonLocations() {
+    //Set button locations
+    gButtons[0].setPosition(0, 0);
+    gButtons[1].setPosition(SCREEN_WIDTH - BUTTON_WIDTH, 0);
+    gButtons[2].setPosition(0, SCREEN_HEIGHT - BUTTON_HEIGHT);
+    gButtons[3].setPosition(SCREEN_WIDTH - BUTTON_WIDTH, SCREEN_HEIGHT - BUTTON_HEIGHT);
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gButtonSpriteSheetTexture.loadFromFile("button.png")) {
+        printf("Error importing texture!\n");
+        success = false;
+    }
+
+    if (!gArrowTexture.loadFromFile("arrow.png")) {
+        printf("Failed to load arrow texture!\n");
+        success = false;
+    }
+
+    return success;
+}
+
+void close() {
+    gButtonSpriteSheetTexture.free();
+    gArrowTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, replays run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool recording = argc > 1 && strcmp( args[1], "--record" ) == 0;
+    bool replaying = argc > 1 && strcmp( args[1], "--replay" ) == 0;
+
+    //Reading frames back stalls the renderer, so timing runs skip the hash
+    bool hashing = recording || ( replaying && !( argc > 2 && strcmp( args[2], "--no-hash" ) == 0 ) );
+    bool passed = true;
+    LInputRecorder recorder;
+    LInputPlayer player;
+    LFrameHasher hasher;
+
+    if (!init( !replaying )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if ( hashing && !hasher.init( SCREEN_WIDTH, SCREEN_HEIGHT ) ) {
+            printf("Failed to allocate frame hash buffer!\n");
+        }
+        else if ( recording && !recorder.open( REPLAY_FILE ) ) {
+            printf("Failed to start recording!\n");
+        }
+        else if ( replaying && !player.load( REPLAY_FILE ) ) {
+            printf("Failed to load replay!\n");
+        }
+        else {
+            bool quit = false;
+            initSpriteClips();
+            initButtonLocations();
+            SDL_Event e; //Variable to Store Event
+            double degrees = 0;
+            SDL_RendererFlip flipType = SDL_FLIP_NONE;
+            int frame = 0;
+
+            //Live input would disturb the replay, pushed events still get through
+            if (replaying) {
+                SDL_EventState( SDL_MOUSEMOTION, SDL_IGNORE );
+                SDL_EventState( SDL_MOUSEBUTTONDOWN, SDL_IGNORE );
+                SDL_EventState( SDL_MOUSEBUTTONUP, SDL_IGNORE );
+                SDL_EventState( SDL_KEYDOWN, SDL_IGNORE );
+                SDL_EventState( SDL_KEYUP, SDL_IGNORE );
+            }
+            Uint64 start = SDL_GetPerformanceCounter();
+
+            //Main Loop
+            while (!quit) {
+                if (replaying)
+                    player.inject( frame );
+
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    if (recording)
+                        recorder.record( frame, &e );
+
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Rotate and flip the arrow like the rotation lesson
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch( e.key.keysym.sym ) {
+                            case SDLK_a:
+                            degrees -= 60;
+                            break;
+
+                            case SDLK_d:
+                            degrees += 60;
+                            break;
+
+                            case SDLK_q:
+                            flipType = SDL_FLIP_HORIZONTAL;
+                            break;
+
+                            case SDLK_w:
+                            flipType = SDL_FLIP_NONE;
+                            break;
+
+                            case SDLK_e:
+                            flipType = SDL_FLIP_VERTICAL;
+                            break;
+                        }
+                    }
+
+                    for (int i = 0; i < TOTAL_BUTTONS; i++)
+                        gButtons[i].handleEvent( &e );
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the texture
+                for (int i = 0; i < TOTAL_BUTTONS; i++)
+                    gButtons[i].render();
+                gArrowTexture.render((SCREEN_WIDTH - gArrowTexture.getWidth())/2, (SCREEN_HEIGHT - gArrowTexture.getHeight())/2, NULL, degrees, NULL, flipType);
+
+                //Back buffer is undefined after presenting, so hash first
+                if (hashing)
+                    hasher.addFrame();
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                ++frame;
+                if (replaying && player.isFinished( frame ))
+                    quit = true;
+            }
+
+            if (recording) {
+                if (!recorder.close( frame, hasher.getHash() ))
+                    printf("Failed to finish recording!\n");
+            }
+            else if (replaying) {
+                double ms = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+                if (hashing) {
+                    passed = frame == player.getFrames() && hasher.getHash() == player.getFrameHash();
+                    printf("Replayed %d frames, frame hash %016llx %s recording\n",
+                        frame, (unsigned long long) hasher.getHash(), passed ? "matches" : "differs from");
+                    printf("Reading back frames dominates this run, time the replay with --replay --no-hash\n");
+                }
+                else {
+                    passed = frame == player.getFrames();
+                    printf("Replayed %d frames in %.2f ms (%.1f fps) without hashing\n", frame, ms, frame * 1000.0 / ms);
+                }
+            }
+        }
+    }
+    close();
+    return passed ? 0 : 1;
+}
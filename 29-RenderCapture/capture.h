@@ -0,0 +1,84 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <SDL2/SDL.h>
+
+//Trace layout: LCaptureHeader, then LCaptureCommand records until the end of the file
+//CAPTURE_TEXTURE commands are followed by the texture's pixels, width * 4 bytes per row
+const Uint32 CAPTURE_MAGIC = 0x50414354; //"TCAP"
+const Uint32 CAPTURE_VERSION = 1;
+
+//Pixel format of texture snapshots
+const Uint32 CAPTURE_PIXEL_FORMAT = SDL_PIXELFORMAT_ARGB8888;
+
+enum LCaptureOp {
+    //New texture, size in dst.w and dst.h, pixels follow
+    CAPTURE_TEXTURE,
+    CAPTURE_DESTROY_TEXTURE,
+
+    //Texture state, color in r g b a, blend in mode
+    CAPTURE_TEXTURE_COLOR,
+    CAPTURE_TEXTURE_ALPHA,
+    CAPTURE_TEXTURE_BLEND,
+
+    //Renderer state
+    CAPTURE_DRAW_COLOR,
+    CAPTURE_DRAW_BLEND,
+    CAPTURE_VIEWPORT,
+
+    //Drawing
+    CAPTURE_CLEAR,
+    CAPTURE_FILL_RECT,
+    CAPTURE_DRAW_RECT,
+    CAPTURE_DRAW_LINE,
+    CAPTURE_DRAW_POINT,
+    CAPTURE_COPY,
+    CAPTURE_COPY_EX,
+
+    //End of frame
+    CAPTURE_PRESENT
+};
+
+//Which optional fields of a command are set, others mean NULL
+enum LCaptureFlags {
+    CAPTURE_HAS_SRC = 1,
+    CAPTURE_HAS_DST = 2,
+    CAPTURE_HAS_CENTER = 4
+};
+
+struct LCaptureHeader {
+    Uint32 magic;
+    Uint32 version;
+
+    //Window size the trace was recorded at
+    Uint32 width;
+    Uint32 height;
+};
+
+//One captured call, every call uses the same record so the trace can be read in place
+struct LCaptureCommand {
+    Uint32 op;
+
+    //Texture id for texture commands
+    Uint32 texture;
+
+    //LCaptureFlags
+    Uint32 flags;
+
+    //SDL_BlendMode or SDL_RendererFlip
+    Uint32 mode;
+
+    //Source rect, dst rect doubles as viewport, fill rect and line endpoints
+    SDL_Rect src;
+    SDL_Rect dst;
+
+    SDL_Point center;
+    double angle;
+
+    Uint8 r;
+    Uint8 g;
+    Uint8 b;
+    Uint8 a;
+};
+
+#endif
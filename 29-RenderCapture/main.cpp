@@ -0,0 +1,649 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <map>
+#include "capture.h"
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const char* CAPTURE_FILE = "capture.bin";
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Forwards draw calls to gRenderer, writing them to a trace while capturing
+class LRenderCapture {
+    public:
+        //Initializes internal variables
+        LRenderCapture();
+
+        //Closes trace
+        ~LRenderCapture();
+
+        //Starts writing a trace, calls before this are only forwarded
+        bool open( std::string path, int width, int height );
+
+        //Finishes the trace
+        void close();
+
+        //Checks if calls are being written
+        bool isCapturing();
+
+        //Gets frames captured so far
+        int getFrames();
+
+        //Creates a texture, snapshotting its pixels into the trace
+        SDL_Texture* createTextureFromSurface( SDL_Surface* surface );
+        void destroyTexture( SDL_Texture* texture );
+
+        //Texture state
+        void setTextureColorMod( SDL_Texture* texture, Uint8 red, Uint8 green, Uint8 blue );
+        void setTextureAlphaMod( SDL_Texture* texture, Uint8 alpha );
+        void setTextureBlendMode( SDL_Texture* texture, SDL_BlendMode blending );
+
+        //Renderer state
+        void setDrawColor( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha );
+        void setDrawBlendMode( SDL_BlendMode blending );
+        void setViewport( const SDL_Rect* rect );
+
+        //Drawing
+        void clear();
+        void fillRect( const SDL_Rect* rect );
+        void drawRect( const SDL_Rect* rect );
+        void drawLine( int x1, int y1, int x2, int y2 );
+        void drawPoint( int x, int y );
+        void copy( SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst );
+        void copyEx( SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst, double angle, const SDL_Point* center, SDL_RendererFlip flip );
+        void present();
+
+    private:
+        //Gets a zeroed command for op
+        LCaptureCommand makeCommand( Uint32 op );
+
+        //Appends command to the trace
+        void write( LCaptureCommand* command );
+
+        //Gets a texture's trace id, false for textures created before capture started or outside it
+        bool findId( SDL_Texture* texture, Uint32* id );
+
+        FILE* mFile;
+
+        //Trace ids of live textures
+        std::map<SDL_Texture*, Uint32> mIds;
+        Uint32 mNextId;
+
+        int mFrames;
+
+        //Commands left out because their texture has no id
+        int mUntracked;
+};
+
+LRenderCapture::LRenderCapture() {
+    mFile = NULL;
+    mNextId = 0;
+    mFrames = 0;
+    mUntracked = 0;
+}
+
+LRenderCapture::~LRenderCapture() {
+    close();
+}
+
+bool LRenderCapture::open( std::string path, int width, int height ) {
+    mFile = fopen( path.c_str(), "wb" );
+    if (mFile == NULL) {
+        printf("Unable to create %s!\n", path.c_str());
+        return false;
+    }
+
+    LCaptureHeader header;
+    header.magic = CAPTURE_MAGIC;
+    header.version = CAPTURE_VERSION;
+    header.width = width;
+    header.height = height;
+    fwrite( &header, sizeof(header), 1, mFile );
+    mFrames = 0;
+    mUntracked = 0;
+    return true;
+}
+
+void LRenderCapture::close() {
+    if (mFile != NULL) {
+        fclose( mFile );
+        mFile = NULL;
+        printf("Captured %d frames to %s\n", mFrames, CAPTURE_FILE);
+        if (mUntracked > 0)
+            printf("Left out %d commands on textures the capture did not create, the replay will differ!\n", mUntracked);
+    }
+}
+
+bool LRenderCapture::isCapturing() {
+    return mFile != NULL;
+}
+
+int LRenderCapture::getFrames() {
+    return mFrames;
+}
+
+LCaptureCommand LRenderCapture::makeCommand( Uint32 op ) {
+    LCaptureCommand command;
+    memset( &command, 0, sizeof(command) );
+    command.op = op;
+    return command;
+}
+
+void LRenderCapture::write( LCaptureCommand* command ) {
+    if (mFile != NULL)
+        fwrite( command, sizeof(LCaptureCommand), 1, mFile );
+}
+
+bool LRenderCapture::findId( SDL_Texture* texture, Uint32* id ) {
+    std::map<SDL_Texture*, Uint32>::iterator found = mIds.find( texture );
+    if (found == mIds.end()) {
+        mUntracked++;
+        return false;
+    }
+    *id = found->second;
+    return true;
+}
+
+SDL_Texture* LRenderCapture::createTextureFromSurface( SDL_Surface* surface ) {
+    SDL_Texture* texture = SDL_CreateTextureFromSurface( gRenderer, surface );
+    if (texture == NULL || mFile == NULL)
+        return texture;
+
+    //Snapshot in one format, color key becomes alpha the same way the renderer sees it
+    SDL_Surface* snapshot = SDL_ConvertSurfaceFormat( surface, CAPTURE_PIXEL_FORMAT, 0 );
+    if (snapshot == NULL) {
+        printf("Unable to snapshot texture! SDL Error: %s\n", SDL_GetError());
+        return texture;
+    }
+
+    Uint32 id = mNextId++;
+    mIds[texture] = id;
+
+    LCaptureCommand command = makeCommand( CAPTURE_TEXTURE );
+    command.texture = id;
+    command.dst.w = snapshot->w;
+    command.dst.h = snapshot->h;
+    write( &command );
+    for (int y = 0; y < snapshot->h; y++)
+        fwrite( (Uint8*) snapshot->pixels + y * snapshot->pitch, snapshot->w * 4, 1, mFile );
+    SDL_FreeSurface( snapshot );
+
+    //Textures from keyed or alpha surfaces start out blended
+    SDL_BlendMode blending;
+    SDL_GetTextureBlendMode( texture, &blending );
+    command = makeCommand( CAPTURE_TEXTURE_BLEND );
+    command.texture = id;
+    command.mode = blending;
+    write( &command );
+    return texture;
+}
+
+void LRenderCapture::destroyTexture( SDL_Texture* texture ) {
+    std::map<SDL_Texture*, Uint32>::iterator found = mIds.find( texture );
+    if (found != mIds.end()) {
+        LCaptureCommand command = makeCommand( CAPTURE_DESTROY_TEXTURE );
+        command.texture = found->second;
+        write( &command );
+        mIds.erase( found );
+    }
+    SDL_DestroyTexture( texture );
+}
+
+void LRenderCapture::setTextureColorMod( SDL_Texture* texture, Uint8 red, Uint8 green, Uint8 blue ) {
+    SDL_SetTextureColorMod( texture, red, green, blue );
+    LCaptureCommand command = makeCommand( CAPTURE_TEXTURE_COLOR );
+    if (mFile != NULL && findId( texture, &command.texture )) {
+        command.r = red;
+        command.g = green;
+        command.b = blue;
+        write( &command );
+    }
+}
+
+void LRenderCapture::setTextureAlphaMod( SDL_Texture* texture, Uint8 alpha ) {
+    SDL_SetTextureAlphaMod( texture, alpha );
+    LCaptureCommand command = makeCommand( CAPTURE_TEXTURE_ALPHA );
+    if (mFile != NULL && findId( texture, &command.texture )) {
+        command.a = alpha;
+        write( &command );
+    }
+}
+
+void LRenderCapture::setTextureBlendMode( SDL_Texture* texture, SDL_BlendMode blending ) {
+    SDL_SetTextureBlendMode( texture, blending );
+    LCaptureCommand command = makeCommand( CAPTURE_TEXTURE_BLEND );
+    if (mFile != NULL && findId( texture, &command.texture )) {
+        command.mode = blending;
+        write( &command );
+    }
+}
+
+void LRenderCapture::setDrawColor( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha ) {
+    SDL_SetRenderDrawColor( gRenderer, red, green, blue, alpha );
+    LCaptureCommand command = makeCommand( CAPTURE_DRAW_COLOR );
+    command.r = red;
+    command.g = green;
+    command.b = blue;
+    command.a = alpha;
+    write( &command );
+}
+
+void LRenderCapture::setDrawBlendMode( SDL_BlendMode blending ) {
+    SDL_SetRenderDrawBlendMode( gRenderer, blending );
+    LCaptureCommand command = makeCommand( CAPTURE_DRAW_BLEND );
+    command.mode = blending;
+    write( &command );
+}
+
+void LRenderCapture::setViewport( const SDL_Rect* rect ) {
+    SDL_RenderSetViewport( gRenderer, rect );
+    LCaptureCommand command = makeCommand( CAPTURE_VIEWPORT );
+    if (rect != NULL) {
+        command.flags = CAPTURE_HAS_DST;
+        command.dst = *rect;
+    }
+    write( &command );
+}
+
+void LRenderCapture::clear() {
+    SDL_RenderClear( gRenderer );
+    LCaptureCommand command = makeCommand( CAPTURE_CLEAR );
+    write( &command );
+}
+
+void LRenderCapture::fillRect( const SDL_Rect* rect ) {
+    SDL_RenderFillRect( gRenderer, rect );
+    LCaptureCommand command = makeCommand( CAPTURE_FILL_RECT );
+    if (rect != NULL) {
+        command.flags = CAPTURE_HAS_DST;
+        command.dst = *rect;
+    }
+    write( &command );
+}
+
+void LRenderCapture::drawRect( const SDL_Rect* rect ) {
+    SDL_RenderDrawRect( gRenderer, rect );
+    LCaptureCommand command = makeCommand( CAPTURE_DRAW_RECT );
+    if (rect != NULL) {
+        command.flags = CAPTURE_HAS_DST;
+        command.dst = *rect;
+    }
+    write( &command );
+}
+
+void LRenderCapture::drawLine( int x1, int y1, int x2, int y2 ) {
+    SDL_RenderDrawLine( gRenderer, x1, y1, x2, y2 );
+    LCaptureCommand command = makeCommand( CAPTURE_DRAW_LINE );
+    command.dst.x = x1;
+    command.dst.y = y1;
+    command.dst.w = x2;
+    command.dst.h = y2;
+    write( &command );
+}
+
+void LRenderCapture::drawPoint( int x, int y ) {
+    SDL_RenderDrawPoint( gRenderer, x, y );
+    LCaptureCommand command = makeCommand( CAPTURE_DRAW_POINT );
+    command.dst.x = x;
+    command.dst.y = y;
+    write( &command );
+}
+
+void LRenderCapture::copy( SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst ) {
+    copyEx( texture, src, dst, 0.0, NULL, SDL_FLIP_NONE );
+}
+
+void LRenderCapture::copyEx( SDL_Texture* texture, const SDL_Rect* src, const SDL_Rect* dst, double angle, const SDL_Point* center, SDL_RendererFlip flip ) {
+    //Unrotated copies go down the cheaper path, in the trace too
+    bool plain = angle == 0.0 && center == NULL && flip == SDL_FLIP_NONE;
+    if (plain)
+        SDL_RenderCopy( gRenderer, texture, src, dst );
+    else
+        SDL_RenderCopyEx( gRenderer, texture, src, dst, angle, center, flip );
+
+    LCaptureCommand command = makeCommand( plain ? CAPTURE_COPY : CAPTURE_COPY_EX );
+    if (mFile == NULL || !findId( texture, &command.texture ))
+        return;
+    if (src != NULL) {
+        command.flags |= CAPTURE_HAS_SRC;
+        command.src = *src;
+    }
+    if (dst != NULL) {
+        command.flags |= CAPTURE_HAS_DST;
+        command.dst = *dst;
+    }
+    if (center != NULL) {
+        command.flags |= CAPTURE_HAS_CENTER;
+        command.center = *center;
+    }
+    command.angle = angle;
+    command.mode = flip;
+    write( &command );
+}
+
+void LRenderCapture::present() {
+    SDL_RenderPresent( gRenderer );
+    if (mFile != NULL) {
+        LCaptureCommand command = makeCommand( CAPTURE_PRESENT );
+        write( &command );
+        mFrames++;
+    }
+}
+
+LRenderCapture gCapture;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set color modulation
+        void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //set alpha modulation
+        void setAlpha( Uint8 alpha );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = gCapture.createTextureFromSurface(loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        gCapture.destroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    gCapture.copyEx(mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue ) {
+    //Modulate Texture
+    gCapture.setTextureColorMod( mTexture, red, green, blue );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    //Set blending function
+    gCapture.setTextureBlendMode( mTexture, blending );
+}
+
+void LTexture::setAlpha( Uint8 alpha ) {
+    gCapture.setTextureAlphaMod( mTexture, alpha );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gModulatedTexture;
+LTexture gBackgroundTexture;
+LTexture gFadeTexture;
+LTexture gArrowTexture;
+LTexture gSpriteSheetTexture;
+SDL_Rect gSpriteClips[ 4 ];
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gModulatedTexture.loadFromFile("colors.png")) {
+        printf("Failed to load colors texture!\n");
+        success = false;
+    }
+
+    if (!gBackgroundTexture.loadFromFile("fadein.png")) {
+        printf("Failed to load background texture!\n");
+        success = false;
+    }
+
+    if (!gFadeTexture.loadFromFile("fadeout.png")) {
+        printf("Failed to load fade texture!\n");
+        success = false;
+    }
+    else
+        gFadeTexture.setBlendMode( SDL_BLENDMODE_BLEND );
+
+    if (!gArrowTexture.loadFromFile("arrow.png")) {
+        printf("Failed to load arrow texture!\n");
+        success = false;
+    }
+
+    if (!gSpriteSheetTexture.loadFromFile("dots.png")) {
+        printf("Failed to load sprite sheet texture!\n");
+        success = false;
+    }
+    else {
+        for (int i = 0; i < 4; i++) {
+            gSpriteClips[i].x = ( i % 2 ) * 100;
+            gSpriteClips[i].y = ( i / 2 ) * 100;
+            gSpriteClips[i].w = 100;
+            gSpriteClips[i].h = 100;
+        }
+    }
+    return success;
+}
+
+//Draws one frame touching every captured call, animated by frame number only
+void renderFrame( int frame ) {
+    SDL_Rect topLeft = { 0, 0, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+    SDL_Rect topRight = { SCREEN_WIDTH / 2, 0, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+    SDL_Rect bottom = { 0, SCREEN_HEIGHT / 2, SCREEN_WIDTH, SCREEN_HEIGHT / 2 };
+
+    //Clear Screen
+    gCapture.setDrawColor( 0xFF, 0xFF, 0xFF, 0xFF );
+    gCapture.clear();
+
+    //Geometry like the geometry lesson
+    gCapture.setViewport( &topLeft );
+    SDL_Rect fillRect = { topLeft.w / 4, topLeft.h / 4, topLeft.w / 2, topLeft.h / 2 };
+    gCapture.setDrawColor( 0xFF, 0x00, 0x00, 0xFF );
+    gCapture.fillRect( &fillRect );
+    SDL_Rect outlineRect = { topLeft.w / 6, topLeft.h / 6, topLeft.w * 2 / 3, topLeft.h * 2 / 3 };
+    gCapture.setDrawColor( 0x00, 0x00, 0x00, 0xFF );
+    gCapture.drawRect( &outlineRect );
+    gCapture.setDrawColor( 0x00, 0xFF, 0x00, 0xFF );
+    gCapture.drawLine( 0, topLeft.h / 2, topLeft.w, topLeft.h / 2 );
+    gCapture.setDrawColor( 0x00, 0x00, 0xFF, 0xFF );
+    for (int i = frame % 4; i < topLeft.h; i += 4)
+        gCapture.drawPoint( topLeft.w / 2, i );
+
+    //Translucent overlay sweeping across
+    gCapture.setDrawBlendMode( SDL_BLENDMODE_BLEND );
+    SDL_Rect sweepRect = { frame % topLeft.w, 0, 40, topLeft.h };
+    gCapture.setDrawColor( 0x00, 0x00, 0x00, 0x40 );
+    gCapture.fillRect( &sweepRect );
+    gCapture.setDrawBlendMode( SDL_BLENDMODE_NONE );
+
+    //Cycling color modulation
+    gCapture.setViewport( &topRight );
+    gModulatedTexture.setColor( frame * 2, frame * 3, frame * 5 );
+    gModulatedTexture.render( 0, 0 );
+
+    //Pulsing fade over a background, with a spinning arrow and sprites on top
+    gCapture.setViewport( &bottom );
+    gBackgroundTexture.render( 0, 0 );
+    int pulse = ( frame * 4 ) % 510;
+    gFadeTexture.setAlpha( pulse < 255 ? pulse : 510 - pulse );
+    gFadeTexture.render( 0, 0 );
+    gArrowTexture.render( ( bottom.w - gArrowTexture.getWidth() ) / 2, ( bottom.h - gArrowTexture.getHeight() ) / 2, NULL, frame, NULL, ( frame / 120 ) % 2 ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE );
+    gSpriteSheetTexture.render( 0, 0, &gSpriteClips[0] );
+    gSpriteSheetTexture.render( bottom.w - 100, 0, &gSpriteClips[1] );
+    gSpriteSheetTexture.render( 0, bottom.h - 100, &gSpriteClips[2] );
+    gSpriteSheetTexture.render( bottom.w - 100, bottom.h - 100, &gSpriteClips[3] );
+
+    gCapture.setViewport( NULL );
+
+    //Update screen
+    gCapture.present();
+}
+
+void close() {
+    gModulatedTexture.free();
+    gBackgroundTexture.free();
+    gFadeTexture.free();
+    gArrowTexture.free();
+    gSpriteSheetTexture.free();
+    gCapture.close();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool capture = argc > 1 && strcmp( args[1], "--capture" ) == 0;
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    //Start before loading so texture snapshots land in the trace
+    else if ( capture && !gCapture.open( CAPTURE_FILE, SCREEN_WIDTH, SCREEN_HEIGHT ) ) {
+        printf("Failed to start capture!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                renderFrame( frame );
+                ++frame;
+            }
+        }
+    }
+    close();
+    return 0;
+}
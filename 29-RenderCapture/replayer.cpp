@@ -0,0 +1,257 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "capture.h"
+
+//Texture snapshot from the trace
+struct LTraceTexture {
+    int width;
+    int height;
+    std::vector<Uint8> pixels;
+};
+
+//Reads the whole trace, commands in order and snapshots by id
+bool loadTrace( std::string path, LCaptureHeader* header, std::vector<LCaptureCommand>* commands, std::vector<LTraceTexture>* textures ) {
+    FILE* file = fopen( path.c_str(), "rb" );
+    if (file == NULL) {
+        printf("Unable to open %s!\n", path.c_str());
+        return false;
+    }
+
+    //Snapshot sizes are checked against what is left of the file before allocating
+    fseek( file, 0, SEEK_END );
+    long fileSize = ftell( file );
+    fseek( file, 0, SEEK_SET );
+
+    bool success = true;
+    if (fread( header, sizeof(LCaptureHeader), 1, file ) != 1 || header->magic != CAPTURE_MAGIC || header->version != CAPTURE_VERSION) {
+        printf("%s is not a capture trace!\n", path.c_str());
+        success = false;
+    }
+
+    LCaptureCommand command;
+    while (success && fread( &command, sizeof(command), 1, file ) == 1) {
+        if (command.op == CAPTURE_TEXTURE) {
+            //Ids are handed out in creation order, so a new one is never past the end
+            long remaining = fileSize - ftell( file );
+            if (command.texture > textures->size() || command.dst.w <= 0 || command.dst.h <= 0 ||
+                command.dst.w > remaining / 4 / command.dst.h) {
+                printf("Texture %u in the trace has a bad id or size!\n", command.texture);
+                success = false;
+                break;
+            }
+            if (command.texture == textures->size())
+                textures->resize( command.texture + 1 );
+            LTraceTexture* texture = &(*textures)[ command.texture ];
+            texture->width = command.dst.w;
+            texture->height = command.dst.h;
+            texture->pixels.resize( (size_t) texture->width * texture->height * 4 );
+            if (fread( &texture->pixels[0], texture->pixels.size(), 1, file ) != 1) {
+                printf("Trace ends inside texture %u!\n", command.texture);
+                success = false;
+            }
+        }
+        commands->push_back( command );
+    }
+    fclose( file );
+    return success;
+}
+
+//Uploads every snapshot so uploads stay out of the timing
+bool createTextures( SDL_Renderer* renderer, std::vector<LTraceTexture>* snapshots, std::vector<SDL_Texture*>* textures ) {
+    textures->assign( snapshots->size(), NULL );
+    for (size_t i = 0; i < snapshots->size(); i++) {
+        LTraceTexture* snapshot = &(*snapshots)[i];
+        if (snapshot->pixels.empty())
+            continue;
+
+        SDL_Texture* texture = SDL_CreateTexture( renderer, CAPTURE_PIXEL_FORMAT, SDL_TEXTUREACCESS_STATIC, snapshot->width, snapshot->height );
+        if (texture == NULL) {
+            printf("Unable to create texture %u! SDL Error: %s\n", (unsigned) i, SDL_GetError());
+            return false;
+        }
+        SDL_UpdateTexture( texture, NULL, &snapshot->pixels[0], snapshot->width * 4 );
+        (*textures)[i] = texture;
+    }
+    return true;
+}
+
+//Reissues one command, returns true at the end of a frame
+bool replay( SDL_Renderer* renderer, LCaptureCommand* command, std::vector<SDL_Texture*>* textures ) {
+    SDL_Texture* texture = command->texture < textures->size() ? (*textures)[ command->texture ] : NULL;
+    const SDL_Rect* src = command->flags & CAPTURE_HAS_SRC ? &command->src : NULL;
+    const SDL_Rect* dst = command->flags & CAPTURE_HAS_DST ? &command->dst : NULL;
+    const SDL_Point* center = command->flags & CAPTURE_HAS_CENTER ? &command->center : NULL;
+
+    switch( command->op ) {
+        //Textures live for the whole run
+        case CAPTURE_TEXTURE:
+        case CAPTURE_DESTROY_TEXTURE:
+        break;
+
+        case CAPTURE_TEXTURE_COLOR:
+        SDL_SetTextureColorMod( texture, command->r, command->g, command->b );
+        break;
+
+        case CAPTURE_TEXTURE_ALPHA:
+        SDL_SetTextureAlphaMod( texture, command->a );
+        break;
+
+        case CAPTURE_TEXTURE_BLEND:
+        SDL_SetTextureBlendMode( texture, (SDL_BlendMode) command->mode );
+        break;
+
+        case CAPTURE_DRAW_COLOR:
+        SDL_SetRenderDrawColor( renderer, command->r, command->g, command->b, command->a );
+        break;
+
+        case CAPTURE_DRAW_BLEND:
+        SDL_SetRenderDrawBlendMode( renderer, (SDL_BlendMode) command->mode );
+        break;
+
+        case CAPTURE_VIEWPORT:
+        SDL_RenderSetViewport( renderer, dst );
+        break;
+
+        case CAPTURE_CLEAR:
+        SDL_RenderClear( renderer );
+        break;
+
+        case CAPTURE_FILL_RECT:
+        SDL_RenderFillRect( renderer, dst );
+        break;
+
+        case CAPTURE_DRAW_RECT:
+        SDL_RenderDrawRect( renderer, dst );
+        break;
+
+        case CAPTURE_DRAW_LINE:
+        SDL_RenderDrawLine( renderer, command->dst.x, command->dst.y, command->dst.w, command->dst.h );
+        break;
+
+        case CAPTURE_DRAW_POINT:
+        SDL_RenderDrawPoint( renderer, command->dst.x, command->dst.y );
+        break;
+
+        case CAPTURE_COPY:
+        SDL_RenderCopy( renderer, texture, src, dst );
+        break;
+
+        case CAPTURE_COPY_EX:
+        SDL_RenderCopyEx( renderer, texture, src, dst, command->angle, center, (SDL_RendererFlip) command->mode );
+        break;
+
+        case CAPTURE_PRESENT:
+        SDL_RenderPresent( renderer );
+        return true;
+    }
+    return false;
+}
+
+void listDrivers() {
+    printf("Render drivers:");
+    for (int i = 0; i < SDL_GetNumRenderDrivers(); i++) {
+        SDL_RendererInfo info;
+        if (SDL_GetRenderDriverInfo( i, &info ) == 0)
+            printf(" %s", info.name);
+    }
+    printf("\n");
+}
+
+int main( int argc, char *args[] ) {
+    if (argc < 2) {
+        printf("Usage: %s <trace> [driver] [--no-batching] [--loops n]\n", args[0]);
+        return 1;
+    }
+
+    std::string driver;
+    bool batching = true;
+    int loops = 1;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp( args[i], "--no-batching" ) == 0)
+            batching = false;
+        else if (strcmp( args[i], "--loops" ) == 0 && i + 1 < argc)
+            loops = atoi( args[++i] );
+        else
+            driver = args[i];
+    }
+
+    LCaptureHeader header;
+    std::vector<LCaptureCommand> commands;
+    std::vector<LTraceTexture> snapshots;
+    if (!loadTrace( args[1], &header, &commands, &snapshots ))
+        return 1;
+
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    listDrivers();
+
+    //Both hints only count if set before the renderer is created
+    if (!driver.empty())
+        SDL_SetHint( SDL_HINT_RENDER_DRIVER, driver.c_str() );
+    SDL_SetHint( SDL_HINT_RENDER_BATCHING, batching ? "1" : "0" );
+
+    SDL_Window* window = SDL_CreateWindow( "Replayer", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, header.width, header.height, SDL_WINDOW_SHOWN );
+    SDL_Renderer* renderer = window != NULL ? SDL_CreateRenderer( window, -1, 0 ) : NULL;
+    std::vector<SDL_Texture*> textures;
+    int result = 1;
+    if (renderer == NULL)
+        printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+    else if (createTextures( renderer, &snapshots, &textures )) {
+        SDL_RendererInfo info;
+        SDL_GetRendererInfo( renderer, &info );
+
+        int frames = 0;
+        double totalMs = 0;
+        double bestMs = 0;
+        double worstMs = 0;
+        bool quit = false;
+        for (int loop = 0; loop < loops && !quit; loop++) {
+            Uint64 frameStart = SDL_GetPerformanceCounter();
+            for (size_t i = 0; i < commands.size() && !quit; i++) {
+                if (!replay( renderer, &commands[i], &textures ))
+                    continue;
+
+                double ms = ( SDL_GetPerformanceCounter() - frameStart ) * 1000.0 / SDL_GetPerformanceFrequency();
+                totalMs += ms;
+                if (frames == 0 || ms < bestMs)
+                    bestMs = ms;
+                if (ms > worstMs)
+                    worstMs = ms;
+                frames++;
+
+                //Keep the window responsive without counting it against the frame
+                SDL_Event e;
+                while (SDL_PollEvent( &e ) != 0) {
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                }
+                frameStart = SDL_GetPerformanceCounter();
+            }
+        }
+
+        if (frames > 0) {
+            printf("%s, batching %s: %d frames, %.3f ms per frame (best %.3f, worst %.3f), %.1f fps\n",
+                info.name, batching ? "on" : "off", frames, totalMs / frames, bestMs, worstMs, frames * 1000.0 / totalMs);
+            result = 0;
+        }
+        else
+            printf("Trace has no frames!\n");
+    }
+
+    for (size_t i = 0; i < textures.size(); i++) {
+        if (textures[i] != NULL)
+            SDL_DestroyTexture( textures[i] );
+    }
+    if (renderer != NULL)
+        SDL_DestroyRenderer( renderer );
+    if (window != NULL)
+        SDL_DestroyWindow( window );
+    SDL_Quit();
+    return result;
+}
@@ -0,0 +1,656 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int WALKING_ANIMATION_FRAMES = 4;
+const int CAPTURE_SLOTS = 4;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Single producer single consumer ring of frame buffers
+//The render thread fills slots, the writer thread drains them, neither ever waits on the other
+class LFrameRing {
+    public:
+        //Initializes internal variables
+        LFrameRing();
+
+        //Deallocates buffers
+        ~LFrameRing();
+
+        //Allocates slots buffers of bytes each
+        bool init( int slots, size_t bytes );
+
+        //Gets the next free slot, NULL if the writer has not caught up
+        Uint8* beginWrite();
+
+        //Hands the slot from beginWrite() to the reader
+        void endWrite();
+
+        //Gets the oldest filled slot, NULL if none
+        Uint8* beginRead();
+
+        //Gives the slot from beginRead() back to the writer
+        void endRead();
+
+        //Deallocates buffers
+        void free();
+
+    private:
+        Uint8** mSlots;
+        int mCount;
+
+        //Slots ever written and read, only the producer moves mHead and only the consumer mTail
+        SDL_atomic_t mHead;
+        SDL_atomic_t mTail;
+};
+
+LFrameRing::LFrameRing() {
+    mSlots = NULL;
+    mCount = 0;
+    SDL_AtomicSet( &mHead, 0 );
+    SDL_AtomicSet( &mTail, 0 );
+}
+
+LFrameRing::~LFrameRing() {
+    free();
+}
+
+bool LFrameRing::init( int slots, size_t bytes ) {
+    free();
+    mSlots = (Uint8**) calloc( slots, sizeof(Uint8*) );
+    if (mSlots == NULL)
+        return false;
+    mCount = slots;
+    for (int i = 0; i < slots; i++) {
+        mSlots[i] = (Uint8*) malloc( bytes );
+        if (mSlots[i] == NULL) {
+            free();
+            return false;
+        }
+    }
+    return true;
+}
+
+Uint8* LFrameRing::beginWrite() {
+    int head = SDL_AtomicGet( &mHead );
+    if (head - SDL_AtomicGet( &mTail ) == mCount)
+        return NULL;
+    return mSlots[ head % mCount ];
+}
+
+void LFrameRing::endWrite() {
+    //Pixels must be visible before the reader sees the new head
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicAdd( &mHead, 1 );
+}
+
+Uint8* LFrameRing::beginRead() {
+    int tail = SDL_AtomicGet( &mTail );
+    if (tail == SDL_AtomicGet( &mHead ))
+        return NULL;
+    SDL_MemoryBarrierAcquire();
+    return mSlots[ tail % mCount ];
+}
+
+void LFrameRing::endRead() {
+    SDL_AtomicAdd( &mTail, 1 );
+}
+
+void LFrameRing::free() {
+    if (mSlots != NULL) {
+        for (int i = 0; i < mCount; i++)
+            ::free( mSlots[i] );
+        ::free( mSlots );
+        mSlots = NULL;
+        mCount = 0;
+    }
+}
+
+//Full range BT.601 in 8.8 fixed point, chroma of a pixel is computed from the 2x2 average
+inline Uint8 toLuma( int r, int g, int b ) {
+    return ( 77 * r + 150 * g + 29 * b + 128 ) >> 8;
+}
+
+inline Uint8 toBlueChroma( int r, int g, int b ) {
+    return ( ( -43 * r - 85 * g + 128 * b ) >> 8 ) + 128;
+}
+
+inline Uint8 toRedChroma( int r, int g, int b ) {
+    return ( ( 128 * r - 107 * g - 21 * b ) >> 8 ) + 128;
+}
+
+#if defined(__SSE2__)
+//Splits 8 ARGB8888 pixels into 16-bit red, green and blue lanes
+inline void unpackPixels( const Uint32* pixels, __m128i* r, __m128i* g, __m128i* b ) {
+    __m128i mask = _mm_set1_epi32( 0xFF );
+    __m128i first = _mm_loadu_si128( (const __m128i*) pixels );
+    __m128i second = _mm_loadu_si128( (const __m128i*) ( pixels + 4 ) );
+    *b = _mm_packs_epi32( _mm_and_si128( first, mask ), _mm_and_si128( second, mask ) );
+    *g = _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( first, 8 ), mask ), _mm_and_si128( _mm_srli_epi32( second, 8 ), mask ) );
+    *r = _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( first, 16 ), mask ), _mm_and_si128( _mm_srli_epi32( second, 16 ), mask ) );
+}
+
+//Same as toLuma() on 8 lanes, the sum fits unsigned 16 bits
+inline __m128i lumaLanes( __m128i r, __m128i g, __m128i b ) {
+    __m128i sum = _mm_add_epi16( _mm_mullo_epi16( r, _mm_set1_epi16( 77 ) ), _mm_mullo_epi16( g, _mm_set1_epi16( 150 ) ) );
+    sum = _mm_add_epi16( sum, _mm_mullo_epi16( b, _mm_set1_epi16( 29 ) ) );
+    return _mm_srli_epi16( _mm_add_epi16( sum, _mm_set1_epi16( 128 ) ), 8 );
+}
+
+//Averages 2x2 blocks of two rows of 16 lanes each into 8 lanes
+inline __m128i averageLanes( __m128i topLeft, __m128i topRight, __m128i bottomLeft, __m128i bottomRight ) {
+    __m128i ones = _mm_set1_epi16( 1 );
+    __m128i left = _mm_madd_epi16( _mm_add_epi16( topLeft, bottomLeft ), ones );
+    __m128i right = _mm_madd_epi16( _mm_add_epi16( topRight, bottomRight ), ones );
+    return _mm_srli_epi16( _mm_add_epi16( _mm_packs_epi32( left, right ), _mm_set1_epi16( 2 ) ), 2 );
+}
+
+//Same as toBlueChroma() and toRedChroma() on 8 lanes, the sums fit signed 16 bits
+inline __m128i chromaLanes( __m128i r, __m128i g, __m128i b, short rWeight, short gWeight, short bWeight ) {
+    __m128i sum = _mm_add_epi16( _mm_mullo_epi16( r, _mm_set1_epi16( rWeight ) ), _mm_mullo_epi16( g, _mm_set1_epi16( gWeight ) ) );
+    sum = _mm_add_epi16( sum, _mm_mullo_epi16( b, _mm_set1_epi16( bWeight ) ) );
+    return _mm_add_epi16( _mm_srai_epi16( sum, 8 ), _mm_set1_epi16( 128 ) );
+}
+#endif
+
+//Converts two rows of ARGB8888 into two rows of luma and one row of each chroma plane
+void convertRowPair( const Uint32* top, const Uint32* bottom, int width, Uint8* topLuma, Uint8* bottomLuma, Uint8* blue, Uint8* red ) {
+    int x = 0;
+
+#if defined(__SSE2__)
+    //16 pixels of each row per step
+    for (; x + 16 <= width; x += 16) {
+        __m128i r[4], g[4], b[4];
+        unpackPixels( top + x, &r[0], &g[0], &b[0] );
+        unpackPixels( top + x + 8, &r[1], &g[1], &b[1] );
+        unpackPixels( bottom + x, &r[2], &g[2], &b[2] );
+        unpackPixels( bottom + x + 8, &r[3], &g[3], &b[3] );
+
+        _mm_storeu_si128( (__m128i*) ( topLuma + x ), _mm_packus_epi16( lumaLanes( r[0], g[0], b[0] ), lumaLanes( r[1], g[1], b[1] ) ) );
+        _mm_storeu_si128( (__m128i*) ( bottomLuma + x ), _mm_packus_epi16( lumaLanes( r[2], g[2], b[2] ), lumaLanes( r[3], g[3], b[3] ) ) );
+
+        __m128i rAverage = averageLanes( r[0], r[1], r[2], r[3] );
+        __m128i gAverage = averageLanes( g[0], g[1], g[2], g[3] );
+        __m128i bAverage = averageLanes( b[0], b[1], b[2], b[3] );
+        __m128i zero = _mm_setzero_si128();
+        _mm_storel_epi64( (__m128i*) ( blue + x / 2 ), _mm_packus_epi16( chromaLanes( rAverage, gAverage, bAverage, -43, -85, 128 ), zero ) );
+        _mm_storel_epi64( (__m128i*) ( red + x / 2 ), _mm_packus_epi16( chromaLanes( rAverage, gAverage, bAverage, 128, -107, -21 ), zero ) );
+    }
+#endif
+
+    //Remaining pixels, or all of them without SSE2
+    for (; x < width; x += 2) {
+        int r = 0, g = 0, b = 0;
+        for (int i = 0; i < 4; i++) {
+            Uint32 pixel = ( i < 2 ? top : bottom )[ x + i % 2 ];
+            int pr = ( pixel >> 16 ) & 0xFF;
+            int pg = ( pixel >> 8 ) & 0xFF;
+            int pb = pixel & 0xFF;
+            ( i < 2 ? topLuma : bottomLuma )[ x + i % 2 ] = toLuma( pr, pg, pb );
+            r += pr;
+            g += pg;
+            b += pb;
+        }
+        r = ( r + 2 ) >> 2;
+        g = ( g + 2 ) >> 2;
+        b = ( b + 2 ) >> 2;
+        blue[ x / 2 ] = toBlueChroma( r, g, b );
+        red[ x / 2 ] = toRedChroma( r, g, b );
+    }
+}
+
+//Reads frames back on the render thread and writes them to disk on another
+class LVideoCapture {
+    public:
+        //Initializes internal variables
+        LVideoCapture();
+
+        //Stops the writer
+        ~LVideoCapture();
+
+        //Opens the output and starts the writer, raw writes RGBA instead of Y4M
+        bool start( std::string path, int width, int height, bool raw );
+
+        //Reads back the current frame, call before presenting
+        void captureFrame();
+
+        //Writes what is queued and joins the writer
+        void stop();
+
+        //Gets counters
+        int getCaptured();
+        int getDropped();
+        int getWritten();
+
+    private:
+        //Writer thread entry
+        static int SDLCALL writerThread( void* data );
+
+        //Drains the ring until stopped
+        void writeFrames();
+
+        //Writes one ARGB8888 frame in the output format
+        void writeFrame( Uint8* pixels );
+
+        LFrameRing mRing;
+        SDL_Thread* mThread;
+
+        //Posted for every queued frame and once more to stop
+        SDL_sem* mFramesReady;
+        SDL_atomic_t mStopping;
+
+        FILE* mFile;
+        bool mRaw;
+        int mWidth;
+        int mHeight;
+
+        //Planar 4:2:0 frame, reused by the writer
+        Uint8* mPlanes;
+
+        int mCaptured;
+        int mDropped;
+        SDL_atomic_t mWritten;
+};
+
+LVideoCapture::LVideoCapture() {
+    mThread = NULL;
+    mFramesReady = NULL;
+    SDL_AtomicSet( &mStopping, 0 );
+    mFile = NULL;
+    mRaw = false;
+    mWidth = 0;
+    mHeight = 0;
+    mPlanes = NULL;
+    mCaptured = 0;
+    mDropped = 0;
+    SDL_AtomicSet( &mWritten, 0 );
+}
+
+LVideoCapture::~LVideoCapture() {
+    stop();
+}
+
+bool LVideoCapture::start( std::string path, int width, int height, bool raw ) {
+    //4:2:0 needs whole 2x2 blocks
+    if (!raw && ( width % 2 != 0 || height % 2 != 0 )) {
+        printf("Y4M capture needs even dimensions!\n");
+        return false;
+    }
+
+    mFile = fopen( path.c_str(), "wb" );
+    if (mFile == NULL) {
+        printf("Unable to create %s!\n", path.c_str());
+        return false;
+    }
+    mRaw = raw;
+    mWidth = width;
+    mHeight = height;
+
+    if (!mRing.init( CAPTURE_SLOTS, (size_t) width * height * 4 )) {
+        printf("Unable to allocate capture buffers!\n");
+        return false;
+    }
+    if (!raw) {
+        mPlanes = (Uint8*) malloc( (size_t) width * height * 3 / 2 );
+        if (mPlanes == NULL) {
+            printf("Unable to allocate YUV frame!\n");
+            return false;
+        }
+        fprintf( mFile, "YUV4MPEG2 W%d H%d F60:1 Ip A1:1 C420jpeg\n", width, height );
+    }
+
+    mFramesReady = SDL_CreateSemaphore( 0 );
+    mThread = SDL_CreateThread( writerThread, "VideoWriter", this );
+    if (mFramesReady == NULL || mThread == NULL) {
+        printf("Unable to start writer thread! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void LVideoCapture::captureFrame() {
+    if (mThread == NULL)
+        return;
+
+    //A full ring means the writer is behind, drop this frame rather than wait
+    Uint8* pixels = mRing.beginWrite();
+    if (pixels == NULL) {
+        mDropped++;
+        return;
+    }
+
+    //The back buffer is undefined after presenting, so this reads just before
+    if (SDL_RenderReadPixels( gRenderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, mWidth * 4 ) != 0) {
+        printf("Unable to read frame! SDL Error: %s\n", SDL_GetError());
+        mDropped++;
+        return;
+    }
+    mRing.endWrite();
+    mCaptured++;
+    SDL_SemPost( mFramesReady );
+}
+
+void LVideoCapture::stop() {
+    if (mThread != NULL) {
+        SDL_AtomicSet( &mStopping, 1 );
+        SDL_SemPost( mFramesReady );
+        SDL_WaitThread( mThread, NULL );
+        mThread = NULL;
+        printf("Captured %d frames, wrote %d, dropped %d\n", mCaptured, getWritten(), mDropped);
+    }
+    if (mFramesReady != NULL) {
+        SDL_DestroySemaphore( mFramesReady );
+        mFramesReady = NULL;
+    }
+    if (mFile != NULL) {
+        fclose( mFile );
+        mFile = NULL;
+    }
+    ::free( mPlanes );
+    mPlanes = NULL;
+    mRing.free();
+}
+
+int LVideoCapture::getCaptured() {
+    return mCaptured;
+}
+
+int LVideoCapture::getDropped() {
+    return mDropped;
+}
+
+int LVideoCapture::getWritten() {
+    return SDL_AtomicGet( &mWritten );
+}
+
+int SDLCALL LVideoCapture::writerThread( void* data ) {
+    ( (LVideoCapture*) data )->writeFrames();
+    return 0;
+}
+
+void LVideoCapture::writeFrames() {
+    while (true) {
+        SDL_SemWait( mFramesReady );
+
+        //Drain everything queued, a post may cover several frames
+        Uint8* pixels;
+        while (( pixels = mRing.beginRead() ) != NULL) {
+            writeFrame( pixels );
+            mRing.endRead();
+            SDL_AtomicIncRef( &mWritten );
+        }
+
+        //Frames queued before stop() were drained above
+        if (SDL_AtomicGet( &mStopping ))
+            break;
+    }
+}
+
+void LVideoCapture::writeFrame( Uint8* pixels ) {
+    if (mRaw) {
+        //ARGB8888 words are B G R A bytes in memory, reorder to R G B A
+        Uint32* words = (Uint32*) pixels;
+        for (int i = 0; i < mWidth * mHeight; i++) {
+            Uint32 pixel = words[i];
+            Uint8* rgba = pixels + i * 4;
+            rgba[0] = ( pixel >> 16 ) & 0xFF;
+            rgba[1] = ( pixel >> 8 ) & 0xFF;
+            rgba[2] = pixel & 0xFF;
+            rgba[3] = pixel >> 24;
+        }
+        fwrite( pixels, (size_t) mWidth * mHeight * 4, 1, mFile );
+        return;
+    }
+
+    Uint8* luma = mPlanes;
+    Uint8* blue = luma + mWidth * mHeight;
+    Uint8* red = blue + mWidth * mHeight / 4;
+    const Uint32* rows = (const Uint32*) pixels;
+    for (int y = 0; y < mHeight; y += 2) {
+        convertRowPair( rows + y * mWidth, rows + ( y + 1 ) * mWidth, mWidth,
+            luma + y * mWidth, luma + ( y + 1 ) * mWidth, blue + y / 2 * mWidth / 2, red + y / 2 * mWidth / 2 );
+    }
+    fputs( "FRAME\n", mFile );
+    fwrite( mPlanes, (size_t) mWidth * mHeight * 3 / 2, 1, mFile );
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+//Walking animation
+SDL_Rect gSpriteClips[ WALKING_ANIMATION_FRAMES ];
+LTexture gSpriteSheetTexture;
+LTexture gArrowTexture;
+LVideoCapture gVideoCapture;
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gSpriteSheetTexture.loadFromFile("foo.png")) {
+        printf("Failed to load walking animation texture!\n");
+        success = false;
+    }
+    else {
+        for (int i = 0; i < WALKING_ANIMATION_FRAMES; i++) {
+            gSpriteClips[i].x = i * 64;
+            gSpriteClips[i].y = 0;
+            gSpriteClips[i].w = 64;
+            gSpriteClips[i].h = 205;
+        }
+    }
+
+    if (!gArrowTexture.loadFromFile("arrow.png")) {
+        printf("Failed to load arrow texture!\n");
+        success = false;
+    }
+    return success;
+}
+
+void close() {
+    gVideoCapture.stop();
+    gSpriteSheetTexture.free();
+    gArrowTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool capture = argc > 1 && strcmp( args[1], "--capture" ) == 0;
+    bool captureRaw = argc > 1 && strcmp( args[1], "--capture-raw" ) == 0;
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if ( capture && !gVideoCapture.start( "capture.y4m", SCREEN_WIDTH, SCREEN_HEIGHT, false ) ) {
+            printf("Failed to start capture!\n");
+        }
+        else if ( captureRaw && !gVideoCapture.start( "capture.rgba", SCREEN_WIDTH, SCREEN_HEIGHT, true ) ) {
+            printf("Failed to start capture!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //SDL_Quit event is pressing X
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Spinning arrow behind a figure walking across the screen
+                gArrowTexture.render( (SCREEN_WIDTH - gArrowTexture.getWidth())/2, (SCREEN_HEIGHT - gArrowTexture.getHeight())/2, NULL, frame * 2 );
+                SDL_Rect* currentClip = &gSpriteClips[ ( frame / 8 ) % WALKING_ANIMATION_FRAMES ];
+                gSpriteSheetTexture.render( ( frame * 3 ) % ( SCREEN_WIDTH + currentClip->w ) - currentClip->w, (SCREEN_HEIGHT - currentClip->h)/2, currentClip );
+
+                //Queue the frame for the writer
+                gVideoCapture.captureFrame();
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                ++frame;
+                if (( capture || captureRaw ) && frame % 60 == 0)
+                    printf("Frame %d: %d captured, %d written, %d dropped\n", frame, gVideoCapture.getCaptured(), gVideoCapture.getWritten(), gVideoCapture.getDropped());
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,513 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_STATIC_SPRITES = 500;
+const int BENCH_FRAMES = 600;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Copies issued this frame
+int gDrawCalls = 0;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Creates blank texture
+        bool createBlank( int width, int height, SDL_TextureAccess access );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set self as render target
+        void setAsRenderTarget();
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+bool LTexture::createBlank( int width, int height, SDL_TextureAccess access ) {
+    //Delete the previous texture
+    free();
+
+    //Create uninitialized texture
+    mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, access, width, height );
+    if (mTexture == NULL)
+        printf("Unable to create blank texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        mWidth = width;
+        mHeight = height;
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+    gDrawCalls++;
+}
+
+void LTexture::setAsRenderTarget() {
+    //Make self render target
+    SDL_SetRenderTarget( gRenderer, mTexture );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    //Set blending function
+    SDL_SetTextureBlendMode( mTexture, blending );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+//Sprite placed on a layer
+struct LLayerSprite {
+    LTexture* texture;
+    int x;
+    int y;
+
+    //Source rect, unused when hasClip is false
+    SDL_Rect clip;
+    bool hasClip;
+};
+
+//Screen sized layer of sprites cached in a render target
+class LLayer {
+    public:
+        //Initializes internal variables
+        LLayer();
+
+        //Creates the cache, opaque layers composite without blending
+        bool init( int width, int height, bool opaque );
+
+        //Deallocates cache
+        void free();
+
+        //Removes every sprite
+        void clear();
+
+        //Places a sprite on the layer
+        void add( LTexture* texture, int x, int y, SDL_Rect* clip = NULL );
+
+        //Makes the next update() redraw the cache
+        void markDirty();
+
+        //Creates the cache again at the same size, after a device reset destroyed it
+        bool recreate();
+
+        //Redraws the cache if dirty, returns sprites drawn
+        int update();
+
+        //Composites the cache with one copy
+        void render();
+
+        //Draws every sprite straight to the screen, for comparison
+        void renderUncached();
+
+        //Gets number of sprites
+        int getSpriteCount();
+
+    private:
+        std::vector<LLayerSprite> mSprites;
+        LTexture mCache;
+        bool mOpaque;
+        bool mDirty;
+};
+
+LLayer::LLayer() {
+    mOpaque = false;
+    mDirty = true;
+}
+
+bool LLayer::init( int width, int height, bool opaque ) {
+    if (!mCache.createBlank( width, height, SDL_TEXTUREACCESS_TARGET ))
+        return false;
+    mOpaque = opaque;
+    mCache.setBlendMode( opaque ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND );
+    mDirty = true;
+    return true;
+}
+
+void LLayer::free() {
+    mCache.free();
+    mSprites.clear();
+}
+
+void LLayer::clear() {
+    mSprites.clear();
+    mDirty = true;
+}
+
+void LLayer::add( LTexture* texture, int x, int y, SDL_Rect* clip ) {
+    LLayerSprite sprite;
+    sprite.texture = texture;
+    sprite.x = x;
+    sprite.y = y;
+    sprite.hasClip = clip != NULL;
+    if (clip != NULL)
+        sprite.clip = *clip;
+    mSprites.push_back( sprite );
+    mDirty = true;
+}
+
+void LLayer::markDirty() {
+    mDirty = true;
+}
+
+bool LLayer::recreate() {
+    //createBlank() frees the old cache first, which forgets its size
+    int width = mCache.getWidth();
+    int height = mCache.getHeight();
+    return init( width, height, mOpaque );
+}
+
+int LLayer::update() {
+    if (!mDirty)
+        return 0;
+
+    //Transparent layers start empty, sprites here only use color key so alpha stays 0 or 255
+    mCache.setAsRenderTarget();
+    if (mOpaque)
+        SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+    else
+        SDL_SetRenderDrawColor( gRenderer, 0x00, 0x00, 0x00, 0x00 );
+    SDL_RenderClear( gRenderer );
+
+    renderUncached();
+    SDL_SetRenderTarget( gRenderer, NULL );
+    mDirty = false;
+    return mSprites.size();
+}
+
+void LLayer::render() {
+    mCache.render( 0, 0 );
+}
+
+void LLayer::renderUncached() {
+    for (size_t i = 0; i < mSprites.size(); i++) {
+        LLayerSprite* sprite = &mSprites[i];
+        sprite->texture->render( sprite->x, sprite->y, sprite->hasClip ? &sprite->clip : NULL );
+    }
+}
+
+int LLayer::getSpriteCount() {
+    return mSprites.size();
+}
+
+//Scene textures
+LTexture gFooTexture;
+LTexture gBackgroundTexture;
+LTexture gDotsTexture;
+SDL_Rect gDotClips[ 4 ];
+
+//Layers from back to front
+LLayer gBackgroundLayer;
+LLayer gDotsLayer;
+
+//Scatters the static sprites, same seed gives the same layout
+void scatterDots( Uint32 seed ) {
+    gDotsLayer.clear();
+    for (int i = 0; i < TOTAL_STATIC_SPRITES; i++) {
+        //Small LCG so the layout is the same on every platform
+        seed = seed * 1664525 + 1013904223;
+        int x = ( seed >> 8 ) % ( SCREEN_WIDTH - 100 );
+        seed = seed * 1664525 + 1013904223;
+        int y = ( seed >> 8 ) % ( SCREEN_HEIGHT - 100 );
+        gDotsLayer.add( &gDotsTexture, x, y, &gDotClips[ i % 4 ] );
+    }
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gFooTexture.loadFromFile("foo.png")) {
+        printf("Failed to load foo texture!\n");
+        success = false;
+    }
+
+    if (!gBackgroundTexture.loadFromFile("background.png")) {
+        printf("Failed to load background texture!\n");
+        success = false;
+    }
+
+    if (!gDotsTexture.loadFromFile("dots.png")) {
+        printf("Failed to load dots texture!\n");
+        success = false;
+    }
+    else {
+        for (int i = 0; i < 4; i++) {
+            gDotClips[i].x = ( i % 2 ) * 100;
+            gDotClips[i].y = ( i / 2 ) * 100;
+            gDotClips[i].w = 100;
+            gDotClips[i].h = 100;
+        }
+    }
+
+    if (!gBackgroundLayer.init( SCREEN_WIDTH, SCREEN_HEIGHT, true ) || !gDotsLayer.init( SCREEN_WIDTH, SCREEN_HEIGHT, false )) {
+        printf("Failed to create layers!\n");
+        success = false;
+    }
+    else {
+        gBackgroundLayer.add( &gBackgroundTexture, 0, 0 );
+        scatterDots( 1 );
+    }
+    return success;
+}
+
+//A device reset destroys every texture, sprites are loaded again and layers recreated
+bool restoreMedia() {
+    bool success = gFooTexture.loadFromFile("foo.png") && gBackgroundTexture.loadFromFile("background.png") &&
+        gDotsTexture.loadFromFile("dots.png") && gBackgroundLayer.recreate() && gDotsLayer.recreate();
+    if (!success)
+        printf("Failed to restore textures after a device reset!\n");
+    return success;
+}
+
+//Draws one frame, the figure walking in front is the only thing that changes
+void renderFrame( int frame, bool cached ) {
+    gDrawCalls = 0;
+
+    //Initialize renderer color
+    SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+    //Clear Screen
+    SDL_RenderClear( gRenderer );
+
+    if (cached) {
+        gBackgroundLayer.update();
+        gDotsLayer.update();
+        gBackgroundLayer.render();
+        gDotsLayer.render();
+    }
+    else {
+        gBackgroundLayer.renderUncached();
+        gDotsLayer.renderUncached();
+    }
+
+    //Dynamic sprite drawn directly every frame
+    gFooTexture.render( ( frame * 2 ) % SCREEN_WIDTH, SCREEN_HEIGHT - gFooTexture.getHeight() );
+
+    //Update screen
+    SDL_RenderPresent( gRenderer );
+}
+
+//Gets average ms per frame over BENCH_FRAMES frames
+double benchmark( bool cached ) {
+    //First cached frame pays for filling the layers, like a load would
+    gBackgroundLayer.markDirty();
+    gDotsLayer.markDirty();
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        renderFrame( frame, cached );
+        SDL_PumpEvents();
+    }
+    return ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_FRAMES;
+}
+
+void close() {
+    gBackgroundLayer.free();
+    gDotsLayer.free();
+    gFooTexture.free();
+    gBackgroundTexture.free();
+    gDotsTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            double uncached = benchmark( false );
+            int uncachedCalls = gDrawCalls;
+            double cached = benchmark( true );
+            printf("%d static sprites: redrawn %.3f ms/frame with %d copies, cached %.3f ms/frame with %d copies\n",
+                TOTAL_STATIC_SPRITES, uncached, uncachedCalls, cached, gDrawCalls);
+        }
+        else {
+            bool quit = false;
+            bool cached = true;
+            Uint32 seed = 1;
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Render targets lost their contents but still exist
+                    else if ( e.type == SDL_RENDER_TARGETS_RESET ) {
+                        gBackgroundLayer.markDirty();
+                        gDotsLayer.markDirty();
+                    }
+                    //The device lost every texture, targets included
+                    else if ( e.type == SDL_RENDER_DEVICE_RESET ) {
+                        restoreMedia();
+                    }
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch( e.key.keysym.sym ) {
+                            //Toggle caching to compare
+                            case SDLK_SPACE:
+                            cached = !cached;
+                            printf("Layer caching %s\n", cached ? "on" : "off");
+                            break;
+
+                            //New layout, only the dots layer is redrawn
+                            case SDLK_r:
+                            scatterDots( ++seed );
+                            break;
+                        }
+                    }
+                }
+                renderFrame( frame, cached );
+                ++frame;
+            }
+        }
+    }
+    close();
+    return 0;
+}
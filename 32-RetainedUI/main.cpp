@@ -0,0 +1,610 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int BUTTON_HEIGHT = 200;
+const int BUTTON_WIDTH = 300;
+const int GRID_COLUMNS = 8;
+const int GRID_ROWS = 8;
+const int MAX_BUTTONS = GRID_COLUMNS * GRID_ROWS;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+enum LButtonSprite {
+    BUTTON_SPRITE_MOUSE_OUT,
+    BUTTON_SPRITE_MOUSE_OVER_MOTION,
+    BUTTON_SPRITE_MOUSE_DOWN,
+    BUTTON_SPRITE_MOUSE_UP,
+    BUTTON_SPRITE_TOTAL
+};
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture
+        bool loadFromFile( std::string path );
+
+        //Creates blank texture
+        bool createBlank( int width, int height, SDL_TextureAccess access );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Renders texture stretched over a rect
+        void renderStretched( SDL_Rect* dst, SDL_Rect* clip = NULL );
+
+        //Set self as render target
+        void setAsRenderTarget();
+
+        //Set blending
+        void setBlendMode( SDL_BlendMode blending );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+bool LTexture::createBlank( int width, int height, SDL_TextureAccess access ) {
+    //Delete the previous texture
+    free();
+
+    //Create uninitialized texture
+    mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_RGBA8888, access, width, height );
+    if (mTexture == NULL)
+        printf("Unable to create blank texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        mWidth = width;
+        mHeight = height;
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::renderStretched( SDL_Rect* dst, SDL_Rect* clip ) {
+    SDL_RenderCopy( gRenderer, mTexture, clip, dst );
+}
+
+void LTexture::setAsRenderTarget() {
+    //Make self render target
+    SDL_SetRenderTarget( gRenderer, mTexture );
+}
+
+void LTexture::setBlendMode( SDL_BlendMode blending ) {
+    //Set blending function
+    SDL_SetTextureBlendMode( mTexture, blending );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gButtonSpriteSheetTexture;
+SDL_Rect gSpriteClips[BUTTON_SPRITE_TOTAL];
+
+class LButton {
+    public:
+        //Initializes internal variables
+        LButton();
+
+        //Set position and size
+        void setRect( int x, int y, int w, int h );
+
+        //Handles mouse event
+        void handleEvent( SDL_Event* e );
+
+        //Shows button sprite on the current target
+        void render();
+
+        //Checks if the sprite changed since the last clearDirty()
+        bool isDirty();
+
+        //Forces a redraw
+        void markDirty();
+
+        //Marks the current sprite as drawn
+        void clearDirty();
+
+        //Gets position and size
+        SDL_Rect* getRect();
+
+    private:
+        //Switches sprite, only a real change needs a redraw
+        void setSprite( LButtonSprite sprite );
+
+        //Position and size
+        SDL_Rect mRect;
+
+        //Currently used global sprite
+        LButtonSprite mCurrentSprite;
+
+        bool mDirty;
+};
+
+LButton::LButton() {
+    mRect.x = 0;
+    mRect.y = 0;
+    mRect.w = BUTTON_WIDTH;
+    mRect.h = BUTTON_HEIGHT;
+
+    mCurrentSprite = BUTTON_SPRITE_MOUSE_OUT;
+    mDirty = true;
+}
+
+void LButton::setRect( int x, int y, int w, int h ) {
+    mRect.x = x;
+    mRect.y = y;
+    mRect.w = w;
+    mRect.h = h;
+    mDirty = true;
+}
+
+void LButton::setSprite( LButtonSprite sprite ) {
+    if (sprite != mCurrentSprite) {
+        mCurrentSprite = sprite;
+        mDirty = true;
+    }
+}
+
+void LButton::handleEvent( SDL_Event* e ) {
+    //If mouse event happend
+    if ( e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN || e->type == SDL_MOUSEBUTTONUP ) {
+        //Get mouse position
+        int x, y;
+        SDL_GetMouseState( &x, &y );
+
+        //Mouse is outside button
+        if (x < mRect.x || x >= mRect.x + mRect.w || y < mRect.y || y >= mRect.y + mRect.h)
+            setSprite( BUTTON_SPRITE_MOUSE_OUT );
+
+        //Mouse is inside button
+        else {
+            //Set mouse over sprite
+            switch( e->type ) {
+                case SDL_MOUSEMOTION:
+                setSprite( BUTTON_SPRITE_MOUSE_OVER_MOTION );
+                break;
+
+                case SDL_MOUSEBUTTONDOWN:
+                setSprite( BUTTON_SPRITE_MOUSE_DOWN );
+                break;
+
+                case SDL_MOUSEBUTTONUP:
+                setSprite( BUTTON_SPRITE_MOUSE_UP );
+                break;
+            }
+        }
+    }
+}
+
+void LButton::render() {
+    //Show current button sprite
+    gButtonSpriteSheetTexture.renderStretched( &mRect, &gSpriteClips[ mCurrentSprite ] );
+}
+
+bool LButton::isDirty() {
+    return mDirty;
+}
+
+void LButton::markDirty() {
+    mDirty = true;
+}
+
+void LButton::clearDirty() {
+    mDirty = false;
+}
+
+SDL_Rect* LButton::getRect() {
+    return &mRect;
+}
+
+//Redraw counters since the last reset
+struct LUIStats {
+    int frames;
+
+    //Button draws into the cache, and what redrawing everything would have cost
+    int redrawn;
+    int immediate;
+
+    //Pixels touched by redraws
+    int damagedPixels;
+};
+
+//Widgets drawn into a cached target, only the ones that changed are redrawn
+class LUILayer {
+    public:
+        //Initializes internal variables
+        LUILayer();
+
+        //Creates the cache
+        bool init( int width, int height );
+
+        //Deallocates cache
+        void free();
+
+        //Adds a widget, the layer does not own it
+        void add( LButton* button );
+
+        //Redraws every widget next update, after losing the cache
+        void markAllDirty();
+
+        //Creates the cache again at the same size, after a device reset destroyed it
+        bool recreate();
+
+        //Redraws dirty widgets into the cache, returns how many
+        int update();
+
+        //Composites the cache with one copy
+        void render();
+
+        //Draws every widget straight to the screen, for comparison
+        void renderImmediate();
+
+        //Gets counters and starts new ones
+        LUIStats takeStats();
+
+    private:
+        std::vector<LButton*> mWidgets;
+        LTexture mCache;
+        LUIStats mStats;
+};
+
+LUILayer::LUILayer() {
+    memset( &mStats, 0, sizeof(mStats) );
+}
+
+bool LUILayer::init( int width, int height ) {
+    if (!mCache.createBlank( width, height, SDL_TEXTUREACCESS_TARGET ))
+        return false;
+    mCache.setBlendMode( SDL_BLENDMODE_BLEND );
+
+    //Start fully transparent
+    mCache.setAsRenderTarget();
+    SDL_SetRenderDrawColor( gRenderer, 0x00, 0x00, 0x00, 0x00 );
+    SDL_RenderClear( gRenderer );
+    SDL_SetRenderTarget( gRenderer, NULL );
+    markAllDirty();
+    return true;
+}
+
+void LUILayer::free() {
+    mCache.free();
+    mWidgets.clear();
+}
+
+void LUILayer::add( LButton* button ) {
+    button->markDirty();
+    mWidgets.push_back( button );
+}
+
+void LUILayer::markAllDirty() {
+    for (size_t i = 0; i < mWidgets.size(); i++)
+        mWidgets[i]->markDirty();
+}
+
+bool LUILayer::recreate() {
+    //createBlank() frees the old cache first, which forgets its size
+    int width = mCache.getWidth();
+    int height = mCache.getHeight();
+    return init( width, height );
+}
+
+int LUILayer::update() {
+    mStats.frames++;
+    mStats.immediate += mWidgets.size();
+
+    int redrawn = 0;
+    for (size_t i = 0; i < mWidgets.size(); i++) {
+        LButton* button = mWidgets[i];
+        if (!button->isDirty())
+            continue;
+
+        //Switch targets only when something changed
+        if (redrawn == 0)
+            mCache.setAsRenderTarget();
+
+        //Erase the old sprite first, its transparent parts would show through
+        SDL_Rect* rect = button->getRect();
+        SDL_SetRenderDrawBlendMode( gRenderer, SDL_BLENDMODE_NONE );
+        SDL_SetRenderDrawColor( gRenderer, 0x00, 0x00, 0x00, 0x00 );
+        SDL_RenderFillRect( gRenderer, rect );
+        button->render();
+        button->clearDirty();
+
+        mStats.damagedPixels += rect->w * rect->h;
+        redrawn++;
+    }
+
+    if (redrawn > 0)
+        SDL_SetRenderTarget( gRenderer, NULL );
+    mStats.redrawn += redrawn;
+    return redrawn;
+}
+
+void LUILayer::render() {
+    mCache.render( 0, 0 );
+}
+
+void LUILayer::renderImmediate() {
+    mStats.frames++;
+    mStats.immediate += mWidgets.size();
+    for (size_t i = 0; i < mWidgets.size(); i++)
+        mWidgets[i]->render();
+}
+
+LUIStats LUILayer::takeStats() {
+    LUIStats stats = mStats;
+    memset( &mStats, 0, sizeof(mStats) );
+    return stats;
+}
+
+LButton gButtons[MAX_BUTTONS];
+int gTotalButtons = 0;
+LUILayer gUILayer;
+
+void initSpriteClips() {
+    for (int i = 0; i < BUTTON_SPRITE_TOTAL; i++) {
+        gSpriteClips[i].x = 0;
+        gSpriteClips[i].y = i*200;
+        gSpriteClips[i].w = BUTTON_WIDTH;
+        gSpriteClips[i].h = BUTTON_HEIGHT;
+    }
+}
+
+void initButtonLocations( bool grid ) {
+    if (grid) {
+        //Small buttons covering the whole screen
+        int width = SCREEN_WIDTH / GRID_COLUMNS;
+        int height = SCREEN_HEIGHT / GRID_ROWS;
+        gTotalButtons = GRID_COLUMNS * GRID_ROWS;
+        for (int i = 0; i < gTotalButtons; i++)
+            gButtons[i].setRect( ( i % GRID_COLUMNS ) * width, ( i / GRID_COLUMNS ) * height, width, height );
+    }
+    else {
+        //Set button locations
+        gTotalButtons = 4;
+        gButtons[0].setRect(0, 0, BUTTON_WIDTH, BUTTON_HEIGHT);
+        gButtons[1].setRect(SCREEN_WIDTH - BUTTON_WIDTH, 0, BUTTON_WIDTH, BUTTON_HEIGHT);
+        gButtons[2].setRect(0, SCREEN_HEIGHT - BUTTON_HEIGHT, BUTTON_WIDTH, BUTTON_HEIGHT);
+        gButtons[3].setRect(SCREEN_WIDTH - BUTTON_WIDTH, SCREEN_HEIGHT - BUTTON_HEIGHT, BUTTON_WIDTH, BUTTON_HEIGHT);
+    }
+
+    for (int i = 0; i < gTotalButtons; i++)
+        gUILayer.add( &gButtons[i] );
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    if (!gButtonSpriteSheetTexture.loadFromFile("button.png")) {
+        printf("Error importing texture!\n");
+        success = false;
+    }
+
+    if (!gUILayer.init( SCREEN_WIDTH, SCREEN_HEIGHT )) {
+        printf("Failed to create UI layer!\n");
+        success = false;
+    }
+
+    return success;
+}
+
+//A device reset destroys every texture, the sheet is loaded again and the cache recreated
+bool restoreMedia() {
+    bool success = gButtonSpriteSheetTexture.loadFromFile("button.png") && gUILayer.recreate();
+    if (!success)
+        printf("Failed to restore textures after a device reset!\n");
+    return success;
+}
+
+void printStats( bool retained ) {
+    LUIStats stats = gUILayer.takeStats();
+    if (retained)
+        printf("Last %d frames: %d of %d button draws, %d pixels redrawn\n", stats.frames, stats.redrawn, stats.immediate, stats.damagedPixels);
+    else
+        printf("Last %d frames: %d button draws drawing immediately\n", stats.frames, stats.immediate);
+}
+
+void close() {
+    gUILayer.free();
+    gButtonSpriteSheetTexture.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize loading for png
+                int imgFlags = IMG_INIT_PNG; //flag for png loading
+                //We pass the flags required to load and it returns flags successfully loaded
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool grid = argc > 1 && strcmp( args[1], "--grid" ) == 0;
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            bool retained = true;
+            initSpriteClips();
+            initButtonLocations( grid );
+            SDL_Event e; //Variable to Store Event
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Cache lost its contents but still exists
+                    else if ( e.type == SDL_RENDER_TARGETS_RESET ) {
+                        gUILayer.markAllDirty();
+                    }
+                    //The device lost every texture, the cache included
+                    else if ( e.type == SDL_RENDER_DEVICE_RESET ) {
+                        restoreMedia();
+                    }
+                    //Space switches to drawing every button every frame
+                    else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE ) {
+                        retained = !retained;
+                        gUILayer.markAllDirty();
+                        printf("Retained UI %s\n", retained ? "on" : "off");
+                    }
+
+                    for (int i = 0; i < gTotalButtons; i++)
+                        gButtons[i].handleEvent( &e );
+                }
+
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Render the buttons
+                if (retained) {
+                    gUILayer.update();
+                    gUILayer.render();
+                }
+                else {
+                    gUILayer.renderImmediate();
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+
+                ++frame;
+                if (frame % 60 == 0)
+                    printStats( retained );
+            }
+        }
+    }
+    close();
+    return 0;
+}
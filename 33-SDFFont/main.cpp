@@ -0,0 +1,642 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Glyphs are rasterized once at this size to build the distance field
+const int SDF_SIZE = 48;
+
+//Distance in pixels either side of the outline the field can represent, also the cell padding
+const int SDF_SPREAD = 6;
+
+const int FIRST_GLYPH = 32;
+const int TOTAL_GLYPHS = 95;
+const int ATLAS_WIDTH = 1024;
+
+//Sizes kept thresholded at once, past this the least recently drawn one is replaced
+const int MAX_BAKED_SIZES = 16;
+
+//Sizes drawn by the comparison
+const int TOTAL_SIZES = 10;
+const int gTextSizes[ TOTAL_SIZES ] = { 10, 12, 14, 18, 22, 28, 34, 42, 52, 64 };
+const char* SAMPLE_TEXT = "The quick brown fox";
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Creates a blended texture from ARGB8888 pixels
+        bool loadFromPixels( void* pixels, int width, int height );
+
+        //Creates image from font string
+        bool loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y, SDL_Rect* clip = NULL, double angle = 0.0, SDL_Point* center = NULL, SDL_RendererFlip flip = SDL_FLIP_NONE );
+
+        //Set color modulation
+        void setColor( Uint8 red, Uint8 green, Uint8 blue );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromPixels( void* pixels, int width, int height ) {
+    //Delete the previous texture
+    free();
+
+    mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height );
+    if (mTexture == NULL)
+        printf("Unable to create texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        SDL_UpdateTexture( mTexture, NULL, pixels, width * 4 );
+        SDL_SetTextureBlendMode( mTexture, SDL_BLENDMODE_BLEND );
+        mWidth = width;
+        mHeight = height;
+    }
+    return mTexture != NULL;
+}
+
+bool LTexture::loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor ) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    SDL_Surface* textSurface = TTF_RenderText_Blended(font, textureText.c_str(), textColor);
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        mTexture = SDL_CreateTextureFromSurface(gRenderer, textSurface);
+        if (mTexture == NULL)
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        else {
+            //Set image dimensions
+            mWidth = textSurface->w;
+            mHeight = textSurface->h;
+        }
+        SDL_FreeSurface(textSurface);
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( int x, int y, SDL_Rect* clip, double angle, SDL_Point* center, SDL_RendererFlip flip) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    //Set clip rendering dimensions
+    if (clip != NULL) {
+        renderquad.w = clip->w;
+        renderquad.h = clip->h;
+    }
+    //Render to screen
+    SDL_RenderCopyEx(gRenderer, mTexture, clip, &renderquad, angle, center, flip);
+}
+
+void LTexture::setColor( Uint8 red, Uint8 green, Uint8 blue ) {
+    //Modulate Texture
+    SDL_SetTextureColorMod( mTexture, red, green, blue );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+//Offset to the nearest pixel of the other kind, for the distance transform
+struct LDistanceOffset {
+    int dx;
+    int dy;
+};
+
+//Two pass 8SSEDT, fills every cell with the offset to the nearest seed cell
+void propagateDistances( std::vector<LDistanceOffset>* grid, int width, int height ) {
+    LDistanceOffset* cells = &(*grid)[0];
+
+    //Takes the neighbour's nearest seed if it is closer
+    #define COMPARE( x, y, ox, oy ) \
+        if (( x ) + ( ox ) >= 0 && ( x ) + ( ox ) < width && ( y ) + ( oy ) >= 0 && ( y ) + ( oy ) < height) { \
+            LDistanceOffset* cell = &cells[ ( y ) * width + ( x ) ]; \
+            LDistanceOffset other = cells[ ( ( y ) + ( oy ) ) * width + ( x ) + ( ox ) ]; \
+            other.dx += ( ox ); \
+            other.dy += ( oy ); \
+            if (other.dx * other.dx + other.dy * other.dy < cell->dx * cell->dx + cell->dy * cell->dy) \
+                *cell = other; \
+        }
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            COMPARE( x, y, -1, 0 );
+            COMPARE( x, y, 0, -1 );
+            COMPARE( x, y, -1, -1 );
+            COMPARE( x, y, 1, -1 );
+        }
+        for (int x = width - 1; x >= 0; x--) {
+            COMPARE( x, y, 1, 0 );
+        }
+    }
+
+    for (int y = height - 1; y >= 0; y--) {
+        for (int x = width - 1; x >= 0; x--) {
+            COMPARE( x, y, 1, 0 );
+            COMPARE( x, y, 0, 1 );
+            COMPARE( x, y, -1, 1 );
+            COMPARE( x, y, 1, 1 );
+        }
+        for (int x = 0; x < width; x++) {
+            COMPARE( x, y, -1, 0 );
+        }
+    }
+
+    #undef COMPARE
+}
+
+//Glyph cell in the atlas, in SDF_SIZE pixels
+struct LSDFGlyph {
+    SDL_Rect cell;
+    int advance;
+};
+
+//Glyphs thresholded at one size, only those drawn at it are kept
+struct LBakedSize {
+    int size;
+
+    //When the size was last drawn
+    Uint32 lastUse;
+
+    //Glyphs drawn at this size, the texture holds exactly these
+    bool used[ TOTAL_GLYPHS ];
+    SDL_Rect cells[ TOTAL_GLYPHS ];
+    LTexture texture;
+};
+
+//Signed distance field of a font's glyphs, drawable at any size
+class LSDFFont {
+    public:
+        //Initializes internal variables
+        LSDFFont();
+
+        //Rasterizes every printable glyph once and builds the field, the font can be closed after
+        bool build( std::string path );
+
+        //Deallocates baked sizes
+        void free();
+
+        //Draws text with its top left at x, y, glyphs are white so color modulates them
+        void render( int x, int y, std::string text, int size, SDL_Color color );
+
+        //Gets line height at size
+        int getLineHeight( int size );
+
+        //Gets bytes held by the field and by baked textures
+        size_t getFieldBytes();
+        size_t getBakedBytes();
+
+    private:
+        //Gets glyphs for size, baking any in text not drawn at that size before
+        LBakedSize* getSize( int size, std::string text );
+
+        //Thresholds the used glyphs at their size into one alpha texture
+        bool bake( LBakedSize* baked );
+
+        //Gets glyph index of a character, '?' for anything outside the atlas
+        int getGlyph( char ch );
+
+        //Distance at a fractional atlas position, in SDF_SIZE pixels
+        float sample( float x, float y );
+
+        //Distances encoded 128 + d * 127 / SDF_SPREAD, inside is above 128
+        std::vector<Uint8> mField;
+        int mFieldWidth;
+        int mFieldHeight;
+
+        LSDFGlyph mGlyphs[ TOTAL_GLYPHS ];
+        int mLineHeight;
+
+        //Sizes already thresholded
+        LBakedSize mBaked[ MAX_BAKED_SIZES ];
+        int mBakedCount;
+        Uint32 mUseClock;
+};
+
+LSDFFont::LSDFFont() {
+    mFieldWidth = 0;
+    mFieldHeight = 0;
+    mLineHeight = 0;
+    mBakedCount = 0;
+    mUseClock = 0;
+}
+
+bool LSDFFont::build( std::string path ) {
+    TTF_Font* font = TTF_OpenFont( path.c_str(), SDF_SIZE );
+    if (font == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        return false;
+    }
+    mLineHeight = TTF_FontHeight( font );
+
+    //Rasterize and shelf pack the padded cells
+    SDL_Surface* glyphSurfaces[ TOTAL_GLYPHS ];
+    SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+    int penX = 0;
+    int penY = 0;
+    int cellHeight = mLineHeight + 2 * SDF_SPREAD;
+    for (int i = 0; i < TOTAL_GLYPHS; i++) {
+        Uint16 ch = FIRST_GLYPH + i;
+        int advance = 0;
+        TTF_GlyphMetrics( font, ch, NULL, NULL, NULL, NULL, &advance );
+        glyphSurfaces[i] = TTF_RenderGlyph_Solid( font, ch, white );
+
+        int width = ( glyphSurfaces[i] != NULL ? glyphSurfaces[i]->w : 0 ) + 2 * SDF_SPREAD;
+        if (penX + width > ATLAS_WIDTH) {
+            penX = 0;
+            penY += cellHeight;
+        }
+        mGlyphs[i].cell.x = penX;
+        mGlyphs[i].cell.y = penY;
+        mGlyphs[i].cell.w = width;
+        mGlyphs[i].cell.h = cellHeight;
+        mGlyphs[i].advance = advance;
+        penX += width;
+    }
+    TTF_CloseFont( font );
+    mFieldWidth = ATLAS_WIDTH;
+    mFieldHeight = penY + cellHeight;
+
+    //Seeds for distance to the nearest inside and nearest outside pixel
+    LDistanceOffset far = { 1 << 12, 1 << 12 };
+    LDistanceOffset seed = { 0, 0 };
+    std::vector<LDistanceOffset> toInside( mFieldWidth * mFieldHeight, far );
+    std::vector<LDistanceOffset> toOutside( mFieldWidth * mFieldHeight, seed );
+    for (int i = 0; i < TOTAL_GLYPHS; i++) {
+        SDL_Surface* surface = glyphSurfaces[i];
+        if (surface == NULL)
+            continue;
+
+        //Solid glyphs are 8-bit with index 0 as background
+        for (int y = 0; y < surface->h; y++) {
+            Uint8* row = (Uint8*) surface->pixels + y * surface->pitch;
+            for (int x = 0; x < surface->w; x++) {
+                if (row[x] != 0) {
+                    int index = ( mGlyphs[i].cell.y + SDF_SPREAD + y ) * mFieldWidth + mGlyphs[i].cell.x + SDF_SPREAD + x;
+                    toInside[index] = seed;
+                    toOutside[index] = far;
+                }
+            }
+        }
+        SDL_FreeSurface( surface );
+    }
+    propagateDistances( &toInside, mFieldWidth, mFieldHeight );
+    propagateDistances( &toOutside, mFieldWidth, mFieldHeight );
+
+    mField.resize( mFieldWidth * mFieldHeight );
+    for (int i = 0; i < mFieldWidth * mFieldHeight; i++) {
+        float inside = sqrtf( (float) ( toInside[i].dx * toInside[i].dx + toInside[i].dy * toInside[i].dy ) );
+        float outside = sqrtf( (float) ( toOutside[i].dx * toOutside[i].dx + toOutside[i].dy * toOutside[i].dy ) );
+
+        //Pixel centers sit half a pixel from the edge on either side
+        float distance = outside > 0 ? outside - 0.5f : -( inside - 0.5f );
+        int encoded = (int) ( 128 + distance * 127 / SDF_SPREAD + 0.5f );
+        mField[i] = encoded < 0 ? 0 : ( encoded > 255 ? 255 : encoded );
+    }
+    return true;
+}
+
+void LSDFFont::free() {
+    for (int i = 0; i < mBakedCount; i++)
+        mBaked[i].texture.free();
+    mBakedCount = 0;
+}
+
+float LSDFFont::sample( float x, float y ) {
+    //Bilinear, clamped to the field
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x > mFieldWidth - 1) x = mFieldWidth - 1;
+    if (y > mFieldHeight - 1) y = mFieldHeight - 1;
+    int x0 = (int) x;
+    int y0 = (int) y;
+    int x1 = x0 + 1 < mFieldWidth ? x0 + 1 : x0;
+    int y1 = y0 + 1 < mFieldHeight ? y0 + 1 : y0;
+    float fx = x - x0;
+    float fy = y - y0;
+    float top = mField[ y0 * mFieldWidth + x0 ] * ( 1 - fx ) + mField[ y0 * mFieldWidth + x1 ] * fx;
+    float bottom = mField[ y1 * mFieldWidth + x0 ] * ( 1 - fx ) + mField[ y1 * mFieldWidth + x1 ] * fx;
+    return ( top * ( 1 - fy ) + bottom * fy - 128 ) * SDF_SPREAD / 127;
+}
+
+bool LSDFFont::bake( LBakedSize* baked ) {
+    //Shelf pack the scaled cells, they are all one line tall
+    float scale = (float) baked->size / SDF_SIZE;
+    int cellHeight = (int) ceilf( ( mLineHeight + 2 * SDF_SPREAD ) * scale );
+    int penX = 0;
+    int penY = 0;
+    int width = 0;
+    for (int i = 0; i < TOTAL_GLYPHS; i++) {
+        if (!baked->used[i])
+            continue;
+        int cellWidth = (int) ceilf( mGlyphs[i].cell.w * scale );
+        if (penX + cellWidth > ATLAS_WIDTH) {
+            penX = 0;
+            penY += cellHeight;
+        }
+        SDL_Rect cell = { penX, penY, cellWidth, cellHeight };
+        baked->cells[i] = cell;
+        penX += cellWidth;
+        width = penX > width ? penX : width;
+    }
+    int height = penY + cellHeight;
+    std::vector<Uint32> pixels( width * height, 0xFFFFFF );
+
+    //SDL_Renderer has no shaders, so the threshold runs here once per glyph and size
+    //One target pixel wide alpha ramp across the outline keeps edges smooth at every scale
+    for (int i = 0; i < TOTAL_GLYPHS; i++) {
+        if (!baked->used[i])
+            continue;
+        SDL_Rect* source = &mGlyphs[i].cell;
+        SDL_Rect* cell = &baked->cells[i];
+        for (int y = 0; y < cell->h; y++) {
+            for (int x = 0; x < cell->w; x++) {
+                float distance = sample( source->x + ( x + 0.5f ) / scale - 0.5f, source->y + ( y + 0.5f ) / scale - 0.5f ) * scale;
+                float alpha = distance + 0.5f;
+                alpha = alpha < 0 ? 0 : ( alpha > 1 ? 1 : alpha );
+                pixels[ ( cell->y + y ) * width + cell->x + x ] = ( (Uint32) ( alpha * 255 + 0.5f ) << 24 ) | 0xFFFFFF;
+            }
+        }
+    }
+    return baked->texture.loadFromPixels( &pixels[0], width, height );
+}
+
+int LSDFFont::getGlyph( char ch ) {
+    int glyph = ch - FIRST_GLYPH;
+    return glyph >= 0 && glyph < TOTAL_GLYPHS ? glyph : '?' - FIRST_GLYPH;
+}
+
+LBakedSize* LSDFFont::getSize( int size, std::string text ) {
+    mUseClock++;
+    LBakedSize* baked = NULL;
+    for (int i = 0; i < mBakedCount && baked == NULL; i++) {
+        if (mBaked[i].size == size)
+            baked = &mBaked[i];
+    }
+
+    //Take a free slot, or replace the size drawn longest ago
+    if (baked == NULL) {
+        if (mBakedCount < MAX_BAKED_SIZES)
+            baked = &mBaked[ mBakedCount++ ];
+        else {
+            baked = &mBaked[0];
+            for (int i = 1; i < mBakedCount; i++) {
+                if (mBaked[i].lastUse < baked->lastUse)
+                    baked = &mBaked[i];
+            }
+        }
+        baked->size = size;
+        baked->texture.free();
+        memset( baked->used, 0, sizeof( baked->used ) );
+    }
+    baked->lastUse = mUseClock;
+
+    //New glyphs rebake the size with everything drawn at it so far
+    bool missing = false;
+    for (size_t i = 0; i < text.size(); i++) {
+        int glyph = getGlyph( text[i] );
+        missing = missing || !baked->used[ glyph ];
+        baked->used[ glyph ] = true;
+    }
+    if (missing && !bake( baked )) {
+        //Starts over next time rather than drawing from a stale texture
+        baked->texture.free();
+        memset( baked->used, 0, sizeof( baked->used ) );
+        return NULL;
+    }
+    return baked;
+}
+
+void LSDFFont::render( int x, int y, std::string text, int size, SDL_Color color ) {
+    LBakedSize* baked = getSize( size, text );
+    if (baked == NULL)
+        return;
+    baked->texture.setColor( color.r, color.g, color.b );
+
+    float scale = (float) size / SDF_SIZE;
+    int padding = (int) ( SDF_SPREAD * scale + 0.5f );
+    float penX = x;
+    for (size_t i = 0; i < text.size(); i++) {
+        int glyph = getGlyph( text[i] );
+        baked->texture.render( (int) ( penX + 0.5f ) - padding, y - padding, &baked->cells[ glyph ] );
+        penX += mGlyphs[glyph].advance * scale;
+    }
+}
+
+int LSDFFont::getLineHeight( int size ) {
+    return mLineHeight * size / SDF_SIZE;
+}
+
+size_t LSDFFont::getFieldBytes() {
+    return mField.size();
+}
+
+size_t LSDFFont::getBakedBytes() {
+    size_t bytes = 0;
+    for (int i = 0; i < mBakedCount; i++)
+        bytes += (size_t) mBaked[i].texture.getWidth() * mBaked[i].texture.getHeight() * 4;
+    return bytes;
+}
+
+LSDFFont gSDFFont;
+LTexture gTTFTexts[ TOTAL_SIZES ];
+
+double elapsedMs( Uint64 start ) {
+    return ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+bool loadMedia() {
+    bool success = true;
+    SDL_Color textColor = { 0, 0, 0, 0xFF };
+
+    //One font open per size, the way the TTF lesson would do it
+    Uint64 start = SDL_GetPerformanceCounter();
+    size_t ttfBytes = 0;
+    for (int i = 0; i < TOTAL_SIZES; i++) {
+        TTF_Font* font = TTF_OpenFont( "lazy.ttf", gTextSizes[i] );
+        if (font == NULL) {
+            printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+            success = false;
+            continue;
+        }
+        if (!gTTFTexts[i].loadFromRenderedText( font, SAMPLE_TEXT, textColor ))
+            success = false;
+        ttfBytes += (size_t) gTTFTexts[i].getWidth() * gTTFTexts[i].getHeight() * 4;
+        TTF_CloseFont( font );
+    }
+    double ttfMs = elapsedMs( start );
+
+    //One font open and one rasterization for every size
+    start = SDL_GetPerformanceCounter();
+    if (!gSDFFont.build( "lazy.ttf" ))
+        success = false;
+    double buildMs = elapsedMs( start );
+
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < TOTAL_SIZES && success; i++)
+        gSDFFont.render( 0, 0, SAMPLE_TEXT, gTextSizes[i], textColor );
+    double bakeMs = elapsedMs( start );
+
+    //Text textures grow with every string drawn, glyph textures only with new glyphs
+    //With one short sample string the memory figures are the TTF path's best case
+    if (success) {
+        printf("TTF: %d font opens and rasterizations, %.2f ms, %.1f KB of text textures\n", TOTAL_SIZES, ttfMs, ttfBytes / 1024.0);
+        printf("SDF: 1 font open and rasterization, %.2f ms building plus %.2f ms thresholding %d sizes, %.1f KB field, %.1f KB of glyph textures\n",
+            buildMs, bakeMs, TOTAL_SIZES, gSDFFont.getFieldBytes() / 1024.0, gSDFFont.getBakedBytes() / 1024.0);
+    }
+    return success;
+}
+
+void close() {
+    gSDFFont.free();
+    for (int i = 0; i < TOTAL_SIZES; i++)
+        gTTFTexts[i].free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            bool sdf = true;
+            SDL_Color textColor = { 0, 0, 0, 0xFF };
+            SDL_Event e; //Variable to Store Event
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Space switches between the two to compare them
+                    else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE ) {
+                        sdf = !sdf;
+                        printf("Showing %s text\n", sdf ? "SDF" : "TTF");
+                    }
+                }
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                //Clear Screen
+                SDL_RenderClear( gRenderer );
+
+                //Every size stacked down the screen
+                int y = 4;
+                for (int i = 0; i < TOTAL_SIZES; i++) {
+                    if (sdf) {
+                        gSDFFont.render( 8, y, SAMPLE_TEXT, gTextSizes[i], textColor );
+                        y += gSDFFont.getLineHeight( gTextSizes[i] );
+                    }
+                    else {
+                        gTTFTexts[i].render( 8, y );
+                        y += gTTFTexts[i].getHeight();
+                    }
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,565 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int GENERATED_LINES = 1000000;
+const int SMALL_LINES = 1000;
+
+//New lines rasterized per frame while scrolling, the rest appear on following frames
+const int RASTER_BUDGET = 8;
+
+const int BENCH_SCROLL_FRAMES = 2000;
+const int BENCH_JUMPS = 200;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Lines of text in one block with an index of where each starts
+class LTextBuffer {
+    public:
+        //Reads a whole file, a failed read leaves the buffer empty
+        bool loadFromFile( std::string path );
+
+        //Makes count lines of log-like text
+        void generate( int count );
+
+        //Gets a line without its newline
+        std::string getLine( int line );
+
+        //Gets number of lines
+        int getLineCount();
+
+    private:
+        //Fills mLineStarts from mText
+        void indexLines();
+
+        std::string mText;
+
+        //Offset of each line, plus one past the end
+        std::vector<size_t> mLineStarts;
+};
+
+bool LTextBuffer::loadFromFile( std::string path ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL) {
+        printf("Unable to open %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+    Sint64 size = SDL_RWsize( file );
+    mText.resize( size > 0 ? size : 0 );
+    bool success = size >= 0 && ( size == 0 || SDL_RWread( file, &mText[0], size, 1 ) == 1 );
+    SDL_RWclose( file );
+    if (!success) {
+        printf("Unable to read %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        std::string().swap( mText );
+    }
+    indexLines();
+    return success;
+}
+
+void LTextBuffer::generate( int count ) {
+    static const char* levels[] = { "INFO", "DEBUG", "WARN", "INFO", "ERROR" };
+    char line[ 128 ];
+    mText.clear();
+    mText.reserve( (size_t) count * 64 );
+    for (int i = 0; i < count; i++) {
+        int length = SDL_snprintf( line, sizeof(line), "%07d [%s] worker-%d handled request %d in %d ms\n",
+            i, levels[ i % 5 ], i % 16, i * 7919 % 100003, i * 31 % 997 );
+        mText.append( line, length );
+    }
+    indexLines();
+}
+
+void LTextBuffer::indexLines() {
+    mLineStarts.clear();
+    mLineStarts.push_back( 0 );
+    for (size_t i = 0; i < mText.size(); i++) {
+        if (mText[i] == '\n')
+            mLineStarts.push_back( i + 1 );
+    }
+
+    //Last line without a newline
+    if (mLineStarts.back() != mText.size())
+        mLineStarts.push_back( mText.size() + 1 );
+}
+
+std::string LTextBuffer::getLine( int line ) {
+    size_t start = mLineStarts[line];
+    size_t end = mLineStarts[ line + 1 ] - 1;
+    return mText.substr( start, end - start );
+}
+
+int LTextBuffer::getLineCount() {
+    return mLineStarts.size() - 1;
+}
+
+//Rasterized line
+struct LCachedLine {
+    int line;
+
+    //NULL for empty lines
+    SDL_Texture* texture;
+    int width;
+    int height;
+};
+
+//Line cache counters
+struct LLineCacheStats {
+    int hits;
+    int misses;
+    int evictions;
+};
+
+//Line textures, least recently drawn are freed first
+class LLineCache {
+    public:
+        //Initializes internal variables
+        LLineCache();
+
+        //Frees textures
+        ~LLineCache();
+
+        //Sets how many lines to keep
+        void setCapacity( int lines );
+
+        //Gets a cached line and marks it recently drawn, NULL on a miss
+        LCachedLine* find( int line );
+
+        //Adds a line, evicting the oldest if full
+        LCachedLine* insert( int line, SDL_Texture* texture, int width, int height );
+
+        //Frees every texture and resets the counters
+        void clear();
+
+        //Gets counters
+        LLineCacheStats getStats();
+
+        //Gets number of cached lines
+        int getSize();
+
+    private:
+        //Most recently drawn at the front
+        std::list<LCachedLine> mLRU;
+        std::map<int, std::list<LCachedLine>::iterator> mIndex;
+        int mCapacity;
+        LLineCacheStats mStats;
+};
+
+LLineCache::LLineCache() {
+    mCapacity = 0;
+    memset( &mStats, 0, sizeof(mStats) );
+}
+
+LLineCache::~LLineCache() {
+    clear();
+}
+
+void LLineCache::setCapacity( int lines ) {
+    mCapacity = lines;
+}
+
+LCachedLine* LLineCache::find( int line ) {
+    std::map<int, std::list<LCachedLine>::iterator>::iterator found = mIndex.find( line );
+    if (found == mIndex.end()) {
+        mStats.misses++;
+        return NULL;
+    }
+    mStats.hits++;
+    mLRU.splice( mLRU.begin(), mLRU, found->second );
+    return &mLRU.front();
+}
+
+LCachedLine* LLineCache::insert( int line, SDL_Texture* texture, int width, int height ) {
+    while (mCapacity > 0 && (int) mLRU.size() >= mCapacity) {
+        LCachedLine* oldest = &mLRU.back();
+        if (oldest->texture != NULL)
+            SDL_DestroyTexture( oldest->texture );
+        mIndex.erase( oldest->line );
+        mLRU.pop_back();
+        mStats.evictions++;
+    }
+
+    LCachedLine cached;
+    cached.line = line;
+    cached.texture = texture;
+    cached.width = width;
+    cached.height = height;
+    mLRU.push_front( cached );
+    mIndex[line] = mLRU.begin();
+    return &mLRU.front();
+}
+
+void LLineCache::clear() {
+    for (std::list<LCachedLine>::iterator it = mLRU.begin(); it != mLRU.end(); ++it) {
+        if (it->texture != NULL)
+            SDL_DestroyTexture( it->texture );
+    }
+    mLRU.clear();
+    mIndex.clear();
+
+    //Counters describe the text cached since the last clear
+    memset( &mStats, 0, sizeof(mStats) );
+}
+
+LLineCacheStats LLineCache::getStats() {
+    return mStats;
+}
+
+int LLineCache::getSize() {
+    return mLRU.size();
+}
+
+//Scrollable pane that only ever touches the lines on screen
+class LTextView {
+    public:
+        //Initializes internal variables
+        LTextView();
+
+        //Sets text, font and the area to draw in
+        void setText( LTextBuffer* buffer, TTF_Font* font, SDL_Rect area );
+
+        //Scrolls by pixels, clamped to the text
+        void scrollBy( int pixels );
+        void scrollTo( int pixel );
+
+        //Draws the visible lines, rasterizing at most budget new ones, -1 for no limit
+        //Returns lines still waiting to be rasterized
+        int render( int budget );
+
+        //Gets scroll limits and line height
+        int getScroll();
+        int getMaxScroll();
+        int getLineHeight();
+
+        //Gets the line texture cache
+        LLineCache* getCache();
+
+    private:
+        //Rasterizes one line, cutting it at the pane's width
+        LCachedLine* rasterize( int line );
+
+        LTextBuffer* mBuffer;
+        TTF_Font* mFont;
+        SDL_Rect mArea;
+        int mLineHeight;
+
+        //Pixels scrolled from the top
+        int mScroll;
+
+        LLineCache mCache;
+};
+
+LTextView::LTextView() {
+    mBuffer = NULL;
+    mFont = NULL;
+    mArea.x = 0;
+    mArea.y = 0;
+    mArea.w = 0;
+    mArea.h = 0;
+    mLineHeight = 1;
+    mScroll = 0;
+}
+
+void LTextView::setText( LTextBuffer* buffer, TTF_Font* font, SDL_Rect area ) {
+    mCache.clear();
+    mBuffer = buffer;
+    mFont = font;
+    mArea = area;
+    mLineHeight = TTF_FontLineSkip( font );
+    mScroll = 0;
+
+    //A few screens of lines so small scrolls back and forth always hit
+    mCache.setCapacity( 4 * ( area.h / mLineHeight + 2 ) );
+}
+
+void LTextView::scrollBy( int pixels ) {
+    scrollTo( mScroll + pixels );
+}
+
+void LTextView::scrollTo( int pixel ) {
+    mScroll = pixel < 0 ? 0 : ( pixel > getMaxScroll() ? getMaxScroll() : pixel );
+}
+
+int LTextView::getScroll() {
+    return mScroll;
+}
+
+int LTextView::getMaxScroll() {
+    int height = mBuffer->getLineCount() * mLineHeight - mArea.h;
+    return height > 0 ? height : 0;
+}
+
+int LTextView::getLineHeight() {
+    return mLineHeight;
+}
+
+LLineCache* LTextView::getCache() {
+    return &mCache;
+}
+
+LCachedLine* LTextView::rasterize( int line ) {
+    std::string text = mBuffer->getLine( line );
+
+    //Cut lines wider than the pane so no texture is bigger than it needs to be
+    int width = 0;
+    TTF_SizeUTF8( mFont, text.c_str(), &width, NULL );
+    while (width > mArea.w && !text.empty()) {
+        size_t keep = text.size() * mArea.w / width;
+        if (keep >= text.size())
+            keep = text.size() - 1;
+        //Do not split a UTF-8 sequence
+        while (keep > 0 && ( text[keep] & 0xC0 ) == 0x80)
+            keep--;
+        text.resize( keep );
+        TTF_SizeUTF8( mFont, text.c_str(), &width, NULL );
+    }
+
+    SDL_Texture* texture = NULL;
+    int height = mLineHeight;
+    if (!text.empty()) {
+        SDL_Color textColor = { 0xD0, 0xD0, 0xD0, 0xFF };
+        SDL_Surface* textSurface = TTF_RenderUTF8_Blended( mFont, text.c_str(), textColor );
+        if (textSurface == NULL)
+            printf("Unable to render line %d! SDL Error: %s\n", line, TTF_GetError());
+        else {
+            texture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
+            width = textSurface->w;
+            height = textSurface->h;
+            SDL_FreeSurface( textSurface );
+        }
+    }
+    return mCache.insert( line, texture, width, height );
+}
+
+int LTextView::render( int budget ) {
+    SDL_RenderSetClipRect( gRenderer, &mArea );
+
+    //Fixed line height makes the first visible line a division, whatever the file size
+    int first = mScroll / mLineHeight;
+    int y = mArea.y - mScroll % mLineHeight;
+    int waiting = 0;
+    for (int line = first; line < mBuffer->getLineCount() && y < mArea.y + mArea.h; line++, y += mLineHeight) {
+        LCachedLine* cached = mCache.find( line );
+        if (cached == NULL) {
+            //Over budget, this line shows up on a later frame
+            if (budget == 0) {
+                waiting++;
+                continue;
+            }
+            cached = rasterize( line );
+            if (budget > 0)
+                budget--;
+        }
+
+        if (cached->texture != NULL) {
+            SDL_Rect renderquad = { mArea.x, y, cached->width, cached->height };
+            SDL_RenderCopy( gRenderer, cached->texture, NULL, &renderquad );
+        }
+    }
+
+    SDL_RenderSetClipRect( gRenderer, NULL );
+    return waiting;
+}
+
+LTextBuffer gTextBuffer;
+LTextView gTextView;
+
+//Draws one frame of the pane
+int renderFrame( int budget ) {
+    //Console background
+    SDL_SetRenderDrawColor( gRenderer, 0x18, 0x18, 0x18, 0xFF );
+    SDL_RenderClear( gRenderer );
+    int waiting = gTextView.render( budget );
+
+    //Scroll bar
+    int maxScroll = gTextView.getMaxScroll();
+    if (maxScroll > 0) {
+        SDL_Rect thumb = { SCREEN_WIDTH - 6, (int) ( (double) gTextView.getScroll() / maxScroll * ( SCREEN_HEIGHT - 20 ) ), 4, 20 };
+        SDL_SetRenderDrawColor( gRenderer, 0x80, 0x80, 0x80, 0xFF );
+        SDL_RenderFillRect( gRenderer, &thumb );
+    }
+
+    //Update screen
+    SDL_RenderPresent( gRenderer );
+    return waiting;
+}
+
+bool loadMedia( std::string path, int lines ) {
+    bool success = true;
+
+    gFont = TTF_OpenFont( "lazy.ttf", 16 );
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    else {
+        if (!path.empty())
+            success = gTextBuffer.loadFromFile( path );
+        else
+            gTextBuffer.generate( lines );
+
+        SDL_Rect area = { 4, 0, SCREEN_WIDTH - 14, SCREEN_HEIGHT };
+        gTextView.setText( &gTextBuffer, gFont, area );
+    }
+    return success;
+}
+
+//Scrolls smoothly then jumps around and prints frame times
+void benchmark( int lines ) {
+    gTextBuffer.generate( lines );
+    SDL_Rect area = { 4, 0, SCREEN_WIDTH - 14, SCREEN_HEIGHT };
+    gTextView.setText( &gTextBuffer, gFont, area );
+
+    //Smooth scrolling through the middle of the file, 3 pixels a frame
+    gTextView.scrollTo( gTextView.getMaxScroll() / 2 );
+    double worst = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < BENCH_SCROLL_FRAMES; frame++) {
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        gTextView.scrollBy( 3 );
+        renderFrame( -1 );
+        SDL_PumpEvents();
+        double ms = ( SDL_GetPerformanceCounter() - frameStart ) * 1000.0 / SDL_GetPerformanceFrequency();
+        if (ms > worst)
+            worst = ms;
+    }
+    double scrollMs = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_SCROLL_FRAMES;
+
+    //Jumps spread over the whole file, every visible line is new
+    start = SDL_GetPerformanceCounter();
+    for (int jump = 0; jump < BENCH_JUMPS; jump++) {
+        gTextView.scrollTo( (int) ( (double) gTextView.getMaxScroll() * ( jump * 37 % BENCH_JUMPS ) / BENCH_JUMPS ) );
+        renderFrame( -1 );
+        SDL_PumpEvents();
+    }
+    double jumpMs = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_JUMPS;
+
+    LLineCacheStats stats = gTextView.getCache()->getStats();
+    printf("%d lines: scrolling %.3f ms/frame (worst %.3f), jumping %.3f ms/frame, %d hits, %d misses, %d evictions, %d textures cached\n",
+        lines, scrollMs, worst, jumpMs, stats.hits, stats.misses, stats.evictions, gTextView.getCache()->getSize());
+}
+
+void close() {
+    gTextView.getCache()->clear();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    std::string path = argc > 1 && !bench ? args[1] : "";
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia( path, GENERATED_LINES ) ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            //Same scrolling on a small and a huge file should cost the same
+            benchmark( SMALL_LINES );
+            benchmark( GENERATED_LINES );
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int page = SCREEN_HEIGHT - gTextView.getLineHeight();
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    else if ( e.type == SDL_MOUSEWHEEL ) {
+                        gTextView.scrollBy( -e.wheel.y * 3 * gTextView.getLineHeight() );
+                    }
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch( e.key.keysym.sym ) {
+                            case SDLK_UP:
+                            gTextView.scrollBy( -gTextView.getLineHeight() );
+                            break;
+
+                            case SDLK_DOWN:
+                            gTextView.scrollBy( gTextView.getLineHeight() );
+                            break;
+
+                            case SDLK_PAGEUP:
+                            gTextView.scrollBy( -page );
+                            break;
+
+                            case SDLK_PAGEDOWN:
+                            gTextView.scrollBy( page );
+                            break;
+
+                            case SDLK_HOME:
+                            gTextView.scrollTo( 0 );
+                            break;
+
+                            case SDLK_END:
+                            gTextView.scrollTo( gTextView.getMaxScroll() );
+                            break;
+                        }
+                    }
+                }
+                renderFrame( RASTER_BUDGET );
+            }
+        }
+    }
+    close();
+    return 0;
+}
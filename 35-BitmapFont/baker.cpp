@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "font.h"
+
+//Atlas rows are at least this wide, wider if one glyph needs it, height grows to fit
+const int ATLAS_WIDTH = 256;
+
+//Empty pixels between glyphs so filtering never bleeds
+const int ATLAS_PADDING = 1;
+
+//Glyph with its coverage while it waits to be packed
+struct LBakedGlyph {
+    LFontGlyph glyph;
+    std::vector<Uint8> coverage;
+};
+
+//Encodes one codepoint so SDL_ttf renders it the way it renders text
+std::string encodeUTF8( Uint16 codepoint ) {
+    std::string text;
+    if (codepoint < 0x80)
+        text += (char) codepoint;
+    else if (codepoint < 0x800) {
+        text += (char) ( 0xC0 | ( codepoint >> 6 ) );
+        text += (char) ( 0x80 | ( codepoint & 0x3F ) );
+    }
+    else {
+        text += (char) ( 0xE0 | ( codepoint >> 12 ) );
+        text += (char) ( 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+        text += (char) ( 0x80 | ( codepoint & 0x3F ) );
+    }
+    return text;
+}
+
+//Renders a glyph as SDL_ttf would in a line of text and trims it to its coverage
+bool bakeGlyph( TTF_Font* font, Uint16 codepoint, LBakedGlyph* baked ) {
+    int minx, maxx, miny, maxy, advance;
+    if (TTF_GlyphMetrics( font, codepoint, &minx, &maxx, &miny, &maxy, &advance ) != 0) {
+        printf("No metrics for U+%04X! SDL_ttf Error: %s\n", codepoint, TTF_GetError());
+        return false;
+    }
+    memset( &baked->glyph, 0, sizeof( baked->glyph ) );
+    baked->glyph.codepoint = codepoint;
+    baked->glyph.advance = advance;
+
+    //Blank glyphs like space only need their advance
+    SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+    SDL_Surface* rendered = TTF_RenderUTF8_Blended( font, encodeUTF8( codepoint ).c_str(), white );
+    if (rendered == NULL)
+        return true;
+    SDL_Surface* surface = SDL_ConvertSurfaceFormat( rendered, SDL_PIXELFORMAT_ARGB8888, 0 );
+    SDL_FreeSurface( rendered );
+    if (surface == NULL) {
+        printf("Unable to convert U+%04X! SDL Error: %s\n", codepoint, SDL_GetError());
+        return false;
+    }
+
+    //Bounds of the pixels with any coverage
+    int left = surface->w, top = surface->h, right = -1, bottom = -1;
+    for (int y = 0; y < surface->h; y++) {
+        Uint32* row = (Uint32*) ( (Uint8*) surface->pixels + y * surface->pitch );
+        for (int x = 0; x < surface->w; x++) {
+            if (( row[x] >> 24 ) != 0) {
+                left = SDL_min( left, x );
+                right = SDL_max( right, x );
+                top = SDL_min( top, y );
+                bottom = SDL_max( bottom, y );
+            }
+        }
+    }
+
+    if (right >= 0) {
+        baked->glyph.w = right - left + 1;
+        baked->glyph.h = bottom - top + 1;
+        baked->glyph.offsetX = left;
+        baked->glyph.offsetY = top;
+        baked->coverage.resize( baked->glyph.w * baked->glyph.h );
+        for (int y = 0; y < baked->glyph.h; y++) {
+            Uint32* row = (Uint32*) ( (Uint8*) surface->pixels + ( top + y ) * surface->pitch );
+            for (int x = 0; x < baked->glyph.w; x++)
+                baked->coverage[ y * baked->glyph.w + x ] = row[ left + x ] >> 24;
+        }
+    }
+    SDL_FreeSurface( surface );
+    return true;
+}
+
+//Orders glyphs tallest first so shelves waste little space
+bool tallerFirst( const LBakedGlyph* a, const LBakedGlyph* b ) {
+    return a->glyph.h > b->glyph.h;
+}
+
+//Narrowest atlas that still fits every glyph on a shelf
+int atlasWidth( std::vector<LBakedGlyph>& glyphs ) {
+    int width = ATLAS_WIDTH;
+    for (size_t i = 0; i < glyphs.size(); i++)
+        width = SDL_max( width, glyphs[i].glyph.w + 2 * ATLAS_PADDING );
+    return width;
+}
+
+//Places glyphs on shelves of the given width and returns atlas height
+int packGlyphs( std::vector<LBakedGlyph>& glyphs, int width ) {
+    std::vector<LBakedGlyph*> order;
+    for (size_t i = 0; i < glyphs.size(); i++)
+        order.push_back( &glyphs[i] );
+    std::stable_sort( order.begin(), order.end(), tallerFirst );
+
+    int x = ATLAS_PADDING, y = ATLAS_PADDING, shelfHeight = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        LFontGlyph& glyph = order[i]->glyph;
+        if (glyph.w == 0)
+            continue;
+        if (x + glyph.w + ATLAS_PADDING > width) {
+            x = ATLAS_PADDING;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        glyph.x = x;
+        glyph.y = y;
+        x += glyph.w + ATLAS_PADDING;
+        shelfHeight = SDL_max( shelfHeight, (int) glyph.h );
+    }
+    return y + shelfHeight + ATLAS_PADDING;
+}
+
+int main( int argc, char *args[] ) {
+    if (argc < 4) {
+        printf("Usage: %s <font.ttf> <size> <output> [first-last]\n", args[0]);
+        return 1;
+    }
+
+    //Printable ASCII unless a range is given
+    int first = 32, last = 126;
+    if (argc > 4 && ( sscanf( args[4], "%i-%i", &first, &last ) != 2 || first < 1 || last > 0xFFFF || first > last )) {
+        printf("Bad character range %s!\n", args[4]);
+        return 1;
+    }
+
+    if (TTF_Init() == -1) {
+        printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+        return 1;
+    }
+
+    int size = atoi( args[2] );
+    TTF_Font* font = TTF_OpenFont( args[1], size );
+    if (font == NULL) {
+        printf("Unable to load font %s! SDL_ttf Error: %s\n", args[1], TTF_GetError());
+        TTF_Quit();
+        return 1;
+    }
+
+    //Glyphs come out in codepoint order, which is the order the loader searches
+    bool success = true;
+    std::vector<LBakedGlyph> glyphs;
+    for (int codepoint = first; success && codepoint <= last; codepoint++) {
+        if (!TTF_GlyphIsProvided( font, codepoint ))
+            continue;
+        LBakedGlyph baked;
+        success = bakeGlyph( font, codepoint, &baked );
+        if (success)
+            glyphs.push_back( baked );
+    }
+
+    //Only pairs that actually move are stored, in (first, second) order
+    std::vector<LFontKerning> kerning;
+    for (size_t a = 0; success && a < glyphs.size(); a++) {
+        for (size_t b = 0; b < glyphs.size(); b++) {
+            int amount = TTF_GetFontKerningSizeGlyphs( font, glyphs[a].glyph.codepoint, glyphs[b].glyph.codepoint );
+            if (amount != 0) {
+                LFontKerning pair;
+                pair.first = glyphs[a].glyph.codepoint;
+                pair.second = glyphs[b].glyph.codepoint;
+                pair.amount = amount;
+                pair.reserved = 0;
+                kerning.push_back( pair );
+            }
+        }
+    }
+
+    LFontHeader header;
+    memset( &header, 0, sizeof( header ) );
+    std::vector<Uint8> atlas;
+    if (success) {
+        header.magic = FONT_MAGIC;
+        header.version = FONT_VERSION;
+        header.pointSize = size;
+        header.height = TTF_FontHeight( font );
+        header.ascent = TTF_FontAscent( font );
+        header.lineSkip = TTF_FontLineSkip( font );
+        header.glyphCount = glyphs.size();
+        header.kerningCount = kerning.size();
+        header.atlasWidth = atlasWidth( glyphs );
+        header.atlasHeight = packGlyphs( glyphs, header.atlasWidth );
+        header.glyphOffset = sizeof( LFontHeader );
+        header.kerningOffset = header.glyphOffset + glyphs.size() * sizeof( LFontGlyph );
+        header.atlasOffset = header.kerningOffset + kerning.size() * sizeof( LFontKerning );
+
+        //Glyph positions are 16-bit, an atlas taller than that can't be addressed
+        if (header.atlasHeight > 0xFFFF) {
+            printf("Atlas would be %d pixels tall, bake fewer glyphs or a smaller size!\n", header.atlasHeight);
+            success = false;
+        }
+    }
+
+    if (success) {
+        //Copy each glyph's coverage into its packed spot
+        atlas.resize( header.atlasWidth * header.atlasHeight, 0 );
+        for (size_t i = 0; i < glyphs.size(); i++) {
+            LFontGlyph& glyph = glyphs[i].glyph;
+            for (int y = 0; y < glyph.h; y++)
+                memcpy( &atlas[ ( glyph.y + y ) * (size_t) header.atlasWidth + glyph.x ], &glyphs[i].coverage[ y * glyph.w ], glyph.w );
+        }
+    }
+
+    FILE* file = NULL;
+    if (success) {
+        file = fopen( args[3], "wb" );
+        if (file == NULL) {
+            printf("Unable to open %s for writing!\n", args[3]);
+            success = false;
+        }
+    }
+
+    if (success) {
+        fwrite( &header, sizeof( header ), 1, file );
+        for (size_t i = 0; i < glyphs.size(); i++)
+            fwrite( &glyphs[i].glyph, sizeof( LFontGlyph ), 1, file );
+        fwrite( kerning.data(), sizeof( LFontKerning ), kerning.size(), file );
+        fwrite( atlas.data(), 1, atlas.size(), file );
+
+        if (fclose( file ) != 0) {
+            printf("Unable to write %s!\n", args[3]);
+            success = false;
+        }
+        else
+            printf("Wrote %d glyphs, %d kerning pairs and a %dx%d atlas to %s, %d bytes\n", header.glyphCount, header.kerningCount,
+                header.atlasWidth, header.atlasHeight, args[3], (int) ( header.atlasOffset + atlas.size() ));
+    }
+
+    TTF_CloseFont( font );
+    TTF_Quit();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <SDL2/SDL.h>
+
+//Font layout: LFontHeader, glyphCount LFontGlyph sorted by codepoint,
+//kerningCount LFontKerning sorted by pair, then an 8-bit coverage atlas
+const Uint32 FONT_MAGIC = 0x544E464C; //"LFNT"
+const Uint32 FONT_VERSION = 1;
+
+struct LFontHeader {
+    Uint32 magic;
+    Uint32 version;
+
+    //Size the font was baked at and its vertical metrics in pixels
+    Sint32 pointSize;
+    Sint32 height;
+    Sint32 ascent;
+    Sint32 lineSkip;
+
+    //Table sizes
+    Uint32 glyphCount;
+    Uint32 kerningCount;
+
+    //Atlas dimensions, one byte of coverage per pixel with no row padding
+    Uint32 atlasWidth;
+    Uint32 atlasHeight;
+
+    //Start of each table from the beginning of the file
+    Uint64 glyphOffset;
+    Uint64 kerningOffset;
+    Uint64 atlasOffset;
+};
+
+struct LFontGlyph {
+    Uint16 codepoint;
+
+    //Trimmed glyph image in the atlas
+    Uint16 x;
+    Uint16 y;
+    Uint16 w;
+    Uint16 h;
+
+    //Image position from the pen, y measured down from the top of the line
+    Sint16 offsetX;
+    Sint16 offsetY;
+
+    //Pen movement after this glyph
+    Sint16 advance;
+};
+
+struct LFontKerning {
+    Uint16 first;
+    Uint16 second;
+
+    //Pixels added between the pair
+    Sint16 amount;
+    Uint16 reserved;
+};
+
+#endif
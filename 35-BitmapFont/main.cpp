@@ -0,0 +1,432 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include "font.h"
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Startup is timed this many times each way
+const int BENCH_RUNS = 20;
+const char* BENCH_TEXT = "Score: 0123456789";
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Font baked by the baker tool, drawn from one atlas texture without SDL_ttf
+class LBitmapFont {
+    public:
+        //Initializes internal variables
+        LBitmapFont();
+
+        //Frees atlas and unmaps file
+        ~LBitmapFont();
+
+        //Maps a baked font and uploads its atlas
+        bool open( std::string path );
+
+        //Frees atlas and unmaps file
+        void free();
+
+        //Draws UTF-8 text with its top left at x, y
+        void renderText( int x, int y, std::string text, SDL_Color color );
+
+        //Gets width text would be drawn with
+        int getTextWidth( std::string text );
+
+        //Gets distance between lines
+        int getLineSkip();
+
+        //Gets size the font was baked at
+        int getPointSize();
+
+    private:
+        //Finds a glyph by binary search, NULL if it was not baked
+        LFontGlyph* findGlyph( Uint32 codepoint );
+
+        //Gets kerning between two codepoints
+        int getKerning( Uint32 first, Uint32 second );
+
+        //Mapping and its size
+        Uint8* mData;
+        size_t mSize;
+
+        //Tables inside the mapping
+        LFontHeader* mHeader;
+        LFontGlyph* mGlyphs;
+        LFontKerning* mKerning;
+
+        //White atlas, glyph coverage in alpha
+        SDL_Texture* mAtlas;
+};
+
+//Reads one codepoint and advances past it, bad bytes read as '?'
+Uint32 decodeUTF8( const char** text ) {
+    const Uint8* s = (const Uint8*) *text;
+    Uint32 codepoint = '?';
+    int length = 1;
+    if (s[0] < 0x80)
+        codepoint = s[0];
+    else if (( s[0] & 0xE0 ) == 0xC0 && ( s[1] & 0xC0 ) == 0x80) {
+        codepoint = ( ( s[0] & 0x1F ) << 6 ) | ( s[1] & 0x3F );
+        length = 2;
+    }
+    else if (( s[0] & 0xF0 ) == 0xE0 && ( s[1] & 0xC0 ) == 0x80 && ( s[2] & 0xC0 ) == 0x80) {
+        codepoint = ( ( s[0] & 0x0F ) << 12 ) | ( ( s[1] & 0x3F ) << 6 ) | ( s[2] & 0x3F );
+        length = 3;
+    }
+    *text += length;
+    return codepoint;
+}
+
+LBitmapFont::LBitmapFont() {
+    mData = NULL;
+    mSize = 0;
+    mHeader = NULL;
+    mGlyphs = NULL;
+    mKerning = NULL;
+    mAtlas = NULL;
+}
+
+LBitmapFont::~LBitmapFont() {
+    free();
+}
+
+bool LBitmapFont::open( std::string path ) {
+    free();
+
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file < 0) {
+        printf("Unable to open font %s!\n", path.c_str());
+        return false;
+    }
+
+    struct stat info;
+    if (fstat( file, &info ) < 0 || (size_t) info.st_size < sizeof( LFontHeader )) {
+        printf("Font %s is truncated!\n", path.c_str());
+        ::close( file );
+        return false;
+    }
+
+    //Mapping stays valid after the descriptor is closed
+    void* data = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+    ::close( file );
+    if (data == MAP_FAILED) {
+        printf("Unable to map font %s!\n", path.c_str());
+        return false;
+    }
+    mData = (Uint8*) data;
+    mSize = info.st_size;
+
+    //Validate every table lies inside the file before reading it
+    mHeader = (LFontHeader*) mData;
+    bool valid = mHeader->magic == FONT_MAGIC && mHeader->version == FONT_VERSION;
+    if (valid) {
+        valid = mHeader->glyphOffset + (Uint64) mHeader->glyphCount * sizeof( LFontGlyph ) <= mSize &&
+            mHeader->kerningOffset + (Uint64) mHeader->kerningCount * sizeof( LFontKerning ) <= mSize &&
+            mHeader->atlasOffset + (Uint64) mHeader->atlasWidth * mHeader->atlasHeight <= mSize;
+    }
+    if (valid) {
+        mGlyphs = (LFontGlyph*) ( mData + mHeader->glyphOffset );
+        mKerning = (LFontKerning*) ( mData + mHeader->kerningOffset );
+        for (Uint32 i = 0; valid && i < mHeader->glyphCount; i++)
+            valid = mGlyphs[i].x + mGlyphs[i].w <= mHeader->atlasWidth && mGlyphs[i].y + mGlyphs[i].h <= mHeader->atlasHeight;
+    }
+    if (!valid) {
+        printf("Font %s is corrupt or from another version!\n", path.c_str());
+        free();
+        return false;
+    }
+
+    //Expand coverage to white pixels with alpha, the only per-pixel work at startup
+    mAtlas = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, mHeader->atlasWidth, mHeader->atlasHeight );
+    if (mAtlas == NULL) {
+        printf("Unable to create atlas for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        free();
+        return false;
+    }
+    Uint8* coverage = mData + mHeader->atlasOffset;
+    Uint32 count = mHeader->atlasWidth * mHeader->atlasHeight;
+    Uint32* pixels = new Uint32[ count ];
+    for (Uint32 i = 0; i < count; i++)
+        pixels[i] = ( (Uint32) coverage[i] << 24 ) | 0xFFFFFF;
+    SDL_UpdateTexture( mAtlas, NULL, pixels, mHeader->atlasWidth * 4 );
+    delete[] pixels;
+    SDL_SetTextureBlendMode( mAtlas, SDL_BLENDMODE_BLEND );
+    return true;
+}
+
+void LBitmapFont::free() {
+    if (mAtlas != NULL) {
+        SDL_DestroyTexture( mAtlas );
+        mAtlas = NULL;
+    }
+    if (mData != NULL) {
+        munmap( mData, mSize );
+        mData = NULL;
+        mSize = 0;
+        mHeader = NULL;
+        mGlyphs = NULL;
+        mKerning = NULL;
+    }
+}
+
+LFontGlyph* LBitmapFont::findGlyph( Uint32 codepoint ) {
+    int low = 0, high = (int) mHeader->glyphCount - 1;
+    while (low <= high) {
+        int middle = ( low + high ) / 2;
+        if (mGlyphs[middle].codepoint == codepoint)
+            return &mGlyphs[middle];
+        else if (mGlyphs[middle].codepoint < codepoint)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return NULL;
+}
+
+int LBitmapFont::getKerning( Uint32 first, Uint32 second ) {
+    //Pairs are sorted by first then second, so compare them as one key
+    Uint32 key = ( first << 16 ) | second;
+    int low = 0, high = (int) mHeader->kerningCount - 1;
+    while (low <= high) {
+        int middle = ( low + high ) / 2;
+        Uint32 pair = ( (Uint32) mKerning[middle].first << 16 ) | mKerning[middle].second;
+        if (pair == key)
+            return mKerning[middle].amount;
+        else if (pair < key)
+            low = middle + 1;
+        else
+            high = middle - 1;
+    }
+    return 0;
+}
+
+void LBitmapFont::renderText( int x, int y, std::string text, SDL_Color color ) {
+    if (mAtlas == NULL)
+        return;
+
+    SDL_SetTextureColorMod( mAtlas, color.r, color.g, color.b );
+    const char* c = text.c_str();
+    Uint32 previous = 0;
+    int penX = x;
+    while (*c != '\0') {
+        Uint32 codepoint = decodeUTF8( &c );
+        if (codepoint == '\n') {
+            penX = x;
+            y += mHeader->lineSkip;
+            previous = 0;
+            continue;
+        }
+
+        LFontGlyph* glyph = findGlyph( codepoint );
+        if (glyph == NULL)
+            glyph = findGlyph( '?' );
+        if (glyph == NULL)
+            continue;
+
+        if (previous != 0)
+            penX += getKerning( previous, glyph->codepoint );
+        if (glyph->w > 0) {
+            SDL_Rect clip = { glyph->x, glyph->y, glyph->w, glyph->h };
+            SDL_Rect renderQuad = { penX + glyph->offsetX, y + glyph->offsetY, glyph->w, glyph->h };
+            SDL_RenderCopy( gRenderer, mAtlas, &clip, &renderQuad );
+        }
+        penX += glyph->advance;
+        previous = glyph->codepoint;
+    }
+}
+
+int LBitmapFont::getTextWidth( std::string text ) {
+    if (mHeader == NULL)
+        return 0;
+
+    const char* c = text.c_str();
+    Uint32 previous = 0;
+    int width = 0;
+    while (*c != '\0') {
+        LFontGlyph* glyph = findGlyph( decodeUTF8( &c ) );
+        if (glyph == NULL)
+            glyph = findGlyph( '?' );
+        if (glyph == NULL)
+            continue;
+        if (previous != 0)
+            width += getKerning( previous, glyph->codepoint );
+        width += glyph->advance;
+        previous = glyph->codepoint;
+    }
+    return width;
+}
+
+int LBitmapFont::getLineSkip() {
+    return mHeader != NULL ? mHeader->lineSkip : 0;
+}
+
+int LBitmapFont::getPointSize() {
+    return mHeader != NULL ? mHeader->pointSize : 0;
+}
+
+LBitmapFont gFont;
+
+bool loadMedia( std::string path ) {
+    bool success = true;
+
+    if (!gFont.open( path )) {
+        printf("Failed to open baked font, run make font first!\n");
+        success = false;
+    }
+    return success;
+}
+
+//Opens the baked font and draws a line, returns ms taken
+double timeBaked( std::string path ) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    LBitmapFont font;
+    SDL_Color textColor = { 0, 0, 0 };
+    if (font.open( path ))
+        font.renderText( 0, 0, BENCH_TEXT, textColor );
+    SDL_RenderFlush( gRenderer );
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+//Starts SDL_ttf, opens the TrueType font at the baked size and draws the same line, returns ms taken
+double timeTTF( int pointSize ) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    TTF_Font* font = NULL;
+    SDL_Texture* texture = NULL;
+    if (TTF_Init() == 0) {
+        font = TTF_OpenFont( "lazy.ttf", pointSize );
+        if (font != NULL) {
+            SDL_Color textColor = { 0, 0, 0, 0xFF };
+            SDL_Surface* textSurface = TTF_RenderUTF8_Blended( font, BENCH_TEXT, textColor );
+            if (textSurface != NULL) {
+                texture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
+                SDL_Rect renderQuad = { 0, 0, textSurface->w, textSurface->h };
+                SDL_RenderCopy( gRenderer, texture, NULL, &renderQuad );
+                SDL_FreeSurface( textSurface );
+            }
+        }
+    }
+    SDL_RenderFlush( gRenderer );
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (texture != NULL)
+        SDL_DestroyTexture( texture );
+    if (font != NULL)
+        TTF_CloseFont( font );
+    TTF_Quit();
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void benchmark( std::string path ) {
+    //First runs pay for page faults and library setup, the rest show steady cost
+    double firstBaked = timeBaked( path );
+    double firstTTF = timeTTF( gFont.getPointSize() );
+    double totalBaked = 0, totalTTF = 0;
+    for (int i = 0; i < BENCH_RUNS; i++) {
+        totalBaked += timeBaked( path );
+        totalTTF += timeTTF( gFont.getPointSize() );
+    }
+
+    printf("              baked font    SDL_ttf\n");
+    printf("first start %10.3f ms %10.3f ms\n", firstBaked, firstTTF);
+    printf("average     %10.3f ms %10.3f ms\n", totalBaked / BENCH_RUNS, totalTTF / BENCH_RUNS);
+}
+
+void close() {
+    gFont.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        //SDL_ttf is only started by the benchmark, drawing never needs it
+        if ( !loadMedia( "lazy.fnt" ) ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            benchmark( "lazy.fnt" );
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            const char* lines[] = { "The quick brown fox jumps over the lazy dog", "AVAST! Wave To Yourself, LT", "Drawn from one atlas, no FreeType" };
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Clear screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                //Center each line using the baked advances and kerning
+                SDL_Color textColor = { 0, 0, 0 };
+                int y = ( SCREEN_HEIGHT - 3 * gFont.getLineSkip() ) / 2;
+                for (int i = 0; i < 3; i++) {
+                    gFont.renderText( ( SCREEN_WIDTH - gFont.getTextWidth( lines[i] ) ) / 2, y, lines[i], textColor );
+                    y += gFont.getLineSkip();
+                    textColor.r += 0x60;
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
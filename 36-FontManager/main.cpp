@@ -0,0 +1,452 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <map>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_SIZES = 8;
+const int gFontSizes[ TOTAL_SIZES ] = { 10, 12, 14, 16, 20, 24, 28, 36 };
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Font file mapped once and shared by every size opened from it
+struct LFontFace {
+    std::string path;
+    Uint8* data;
+    size_t size;
+
+    //Number of open fonts reading from this mapping
+    int refCount;
+};
+
+//Font at one size and style, handed out to everyone asking for the same
+struct LCachedFont {
+    TTF_Font* font;
+    LFontFace* face;
+    int pointSize;
+    int style;
+
+    //Number of holders of this font
+    int refCount;
+};
+
+//Opens each face once and each (face, size, style) once
+class LFontManager {
+    public:
+        //Initializes internal variables
+        LFontManager();
+
+        //Gets a shared font, opening it over the face's mapping on first use
+        LCachedFont* acquire( std::string path, int pointSize, int style = TTF_STYLE_NORMAL );
+
+        //Drops a reference, closing the font and unmapping the face with the last ones
+        void release( LCachedFont* entry );
+
+        //Prints hit and miss counts and mapped bytes
+        void printStats();
+
+    private:
+        //Maps a font file, or gets the existing mapping
+        LFontFace* acquireFace( std::string path );
+
+        //Unmaps a face no font uses anymore
+        void releaseFace( LFontFace* face );
+
+        //Faces by path, fonts by path, size and style
+        std::map<std::string, LFontFace*> mFaces;
+        std::map<std::string, LCachedFont*> mFonts;
+
+        int mHits;
+        int mMisses;
+};
+
+LFontManager::LFontManager() {
+    mHits = 0;
+    mMisses = 0;
+}
+
+LFontFace* LFontManager::acquireFace( std::string path ) {
+    std::map<std::string, LFontFace*>::iterator found = mFaces.find( path );
+    if (found != mFaces.end()) {
+        found->second->refCount++;
+        return found->second;
+    }
+
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file < 0) {
+        printf("Unable to open font %s!\n", path.c_str());
+        return NULL;
+    }
+
+    struct stat info;
+    if (fstat( file, &info ) < 0 || info.st_size == 0) {
+        printf("Font %s is empty!\n", path.c_str());
+        ::close( file );
+        return NULL;
+    }
+
+    //Shared read only pages come from the page cache, so other instances map the same memory
+    void* data = mmap( NULL, info.st_size, PROT_READ, MAP_SHARED, file, 0 );
+    ::close( file );
+    if (data == MAP_FAILED) {
+        printf("Unable to map font %s!\n", path.c_str());
+        return NULL;
+    }
+
+    LFontFace* face = new LFontFace;
+    face->path = path;
+    face->data = (Uint8*) data;
+    face->size = info.st_size;
+    face->refCount = 1;
+    mFaces[path] = face;
+    return face;
+}
+
+void LFontManager::releaseFace( LFontFace* face ) {
+    if (--face->refCount > 0)
+        return;
+
+    mFaces.erase( face->path );
+    munmap( face->data, face->size );
+    delete face;
+}
+
+LCachedFont* LFontManager::acquire( std::string path, int pointSize, int style ) {
+    //Style is state of the TTF_Font, so it is part of the key
+    char key[ 32 ];
+    SDL_snprintf( key, sizeof(key), "#%d#%d", pointSize, style );
+    std::string fullKey = path + key;
+
+    std::map<std::string, LCachedFont*>::iterator found = mFonts.find( fullKey );
+    if (found != mFonts.end()) {
+        found->second->refCount++;
+        mHits++;
+        return found->second;
+    }
+
+    LFontFace* face = acquireFace( path );
+    if (face == NULL)
+        return NULL;
+
+    //Each size reads the shared mapping, the file itself is never read again
+    TTF_Font* font = TTF_OpenFontRW( SDL_RWFromConstMem( face->data, face->size ), 1, pointSize );
+    if (font == NULL) {
+        printf("Unable to open %s at %d! SDL_ttf Error: %s\n", path.c_str(), pointSize, TTF_GetError());
+        releaseFace( face );
+        return NULL;
+    }
+    TTF_SetFontStyle( font, style );
+
+    LCachedFont* entry = new LCachedFont;
+    entry->font = font;
+    entry->face = face;
+    entry->pointSize = pointSize;
+    entry->style = style;
+    entry->refCount = 1;
+    mFonts[fullKey] = entry;
+    mMisses++;
+    return entry;
+}
+
+void LFontManager::release( LCachedFont* entry ) {
+    if (--entry->refCount > 0)
+        return;
+
+    std::map<std::string, LCachedFont*>::iterator it = mFonts.begin();
+    while (it != mFonts.end()) {
+        if (it->second == entry)
+            mFonts.erase( it++ );
+        else
+            ++it;
+    }
+
+    //Font reads the mapping until it is closed
+    TTF_CloseFont( entry->font );
+    releaseFace( entry->face );
+    delete entry;
+}
+
+void LFontManager::printStats() {
+    size_t mapped = 0;
+    for (std::map<std::string, LFontFace*>::iterator it = mFaces.begin(); it != mFaces.end(); ++it)
+        mapped += it->second->size;
+    printf("Font manager: %d hits, %d misses, %d fonts open over %d faces, %.1f KB mapped\n", mHits, mMisses, (int) mFonts.size(), (int) mFaces.size(), mapped / 1024.0);
+}
+
+LFontManager gFontManager;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Creates image from font string
+        bool loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture at a given point
+        void render( int x, int y );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+void LTexture::free() {
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+bool LTexture::loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor ) {
+    //Free the previous texture
+    free();
+    //Render text surface
+    SDL_Surface* textSurface = TTF_RenderText_Blended( font, textureText.c_str(), textColor );
+    if (textSurface == NULL)
+        printf("Unable to render text surface! SDL Error: %s\n", TTF_GetError());
+    else {
+        mTexture = SDL_CreateTextureFromSurface( gRenderer, textSurface );
+        if (mTexture == NULL)
+            printf("Cannot create texture! SDL Error: %s\n", SDL_GetError());
+        else {
+            //Set image dimensions
+            mWidth = textSurface->w;
+            mHeight = textSurface->h;
+        }
+        SDL_FreeSurface( textSurface );
+    }
+
+    //Return success or failure
+    return mTexture != NULL;
+}
+
+void LTexture::render( int x, int y ) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    SDL_RenderCopy( gRenderer, mTexture, NULL, &renderquad );
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+LCachedFont* gFonts[ TOTAL_SIZES ];
+LTexture gTextTextures[ TOTAL_SIZES ];
+
+//Gets resident memory of this process in KB
+long getResidentKB() {
+    long pages = 0, resident = 0;
+    FILE* statm = fopen( "/proc/self/statm", "r" );
+    if (statm != NULL) {
+        if (fscanf( statm, "%ld %ld", &pages, &resident ) != 2)
+            resident = 0;
+        fclose( statm );
+    }
+    return resident * ( sysconf( _SC_PAGESIZE ) / 1024 );
+}
+
+//Loads every size and renders a line with each, in a fresh process so freed memory does not skew the next run
+void measureResident( bool shared ) {
+    pid_t child = fork();
+    if (child < 0) {
+        printf("Unable to fork!\n");
+        return;
+    }
+    if (child > 0) {
+        waitpid( child, NULL, 0 );
+        return;
+    }
+
+    TTF_Init();
+    long before = getResidentKB();
+    TTF_Font* fonts[ TOTAL_SIZES ];
+    LCachedFont* entries[ TOTAL_SIZES ];
+    SDL_Color textColor = { 0, 0, 0, 0xFF };
+    for (int i = 0; i < TOTAL_SIZES; i++) {
+        if (shared) {
+            entries[i] = gFontManager.acquire( "lazy.ttf", gFontSizes[i] );
+            fonts[i] = entries[i] != NULL ? entries[i]->font : NULL;
+        }
+        else
+            fonts[i] = TTF_OpenFont( "lazy.ttf", gFontSizes[i] );
+
+        //Glyphs get loaded on first render, count them too
+        if (fonts[i] != NULL)
+            SDL_FreeSurface( TTF_RenderText_Blended( fonts[i], "The quick brown fox jumps over the lazy dog", textColor ) );
+    }
+    long after = getResidentKB();
+    printf("%-22s %8ld KB\n", shared ? "shared mapping" : "TTF_OpenFont per size", after - before);
+    if (shared)
+        gFontManager.printStats();
+    fflush( stdout );
+    _exit( 0 );
+}
+
+void benchmark() {
+    printf("Resident memory added by %d sizes of lazy.ttf\n", TOTAL_SIZES);
+    measureResident( false );
+    measureResident( true );
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    SDL_Color textColor = { 0, 0, 0, 0xFF };
+    for (int i = 0; i < TOTAL_SIZES && success; i++) {
+        gFonts[i] = gFontManager.acquire( "lazy.ttf", gFontSizes[i] );
+        if (gFonts[i] == NULL) {
+            printf("Failed to load lazy.ttf at %d!\n", gFontSizes[i]);
+            success = false;
+        }
+        else {
+            char text[ 64 ];
+            SDL_snprintf( text, sizeof(text), "%d point, one mapping", gFontSizes[i] );
+            if (!gTextTextures[i].loadFromRenderedText( gFonts[i]->font, text, textColor ))
+                success = false;
+        }
+    }
+
+    //Asking again for a size already open only bumps its count
+    LCachedFont* again = gFontManager.acquire( "lazy.ttf", gFontSizes[0] );
+    if (again != NULL)
+        gFontManager.release( again );
+    gFontManager.printStats();
+    return success;
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_SIZES; i++) {
+        gTextTextures[i].free();
+        if (gFonts[i] != NULL) {
+            gFontManager.release( gFonts[i] );
+            gFonts[i] = NULL;
+        }
+    }
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    //Memory is measured without a window so the renderer does not add noise
+    if (argc > 1 && strcmp( args[1], "--bench" ) == 0) {
+        benchmark();
+        return 0;
+    }
+
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Clear screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                //Every size stacked down the screen
+                int y = 10;
+                for (int i = 0; i < TOTAL_SIZES; i++) {
+                    gTextTextures[i].render( ( SCREEN_WIDTH - gTextTextures[i].getWidth() ) / 2, y );
+                    y += gTextTextures[i].getHeight() + 8;
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
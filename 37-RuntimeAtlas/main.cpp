@@ -0,0 +1,701 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Atlas pages are square, one streaming texture each
+const int ATLAS_PAGE_SIZE = 1024;
+
+//Empty pixels right and below each region so filtering never bleeds
+const int ATLAS_PADDING = 1;
+
+//Pages with more than this share of their claimed area unused get repacked
+const double DEFRAG_THRESHOLD = 0.35;
+const int DEFRAG_INTERVAL = 300;
+
+//Images alive at once and how long each lives
+const int MAX_ITEMS = 400;
+const int ITEM_LIFETIME = 240;
+const int SPAWNS_PER_FRAME = 4;
+
+const int BENCH_FRAMES = 3000;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font *gFont = NULL;
+
+//Texture changes between consecutive copies, each one ends a batch
+int gTextureSwitches = 0;
+SDL_Texture* gLastTexture = NULL;
+
+//Copies a texture and counts batches broken
+void renderCopy( SDL_Texture* texture, SDL_Rect* clip, SDL_Rect* renderQuad ) {
+    if (texture != gLastTexture) {
+        gTextureSwitches++;
+        gLastTexture = texture;
+    }
+    SDL_RenderCopy( gRenderer, texture, clip, renderQuad );
+}
+
+//Free run of pixels on a shelf
+struct LAtlasSpan {
+    int x;
+    int w;
+};
+
+//Row of regions sharing one height
+struct LAtlasShelf {
+    int y;
+    int h;
+
+    //Free spans sorted by x, neighbours are always merged
+    std::vector<LAtlasSpan> freeSpans;
+};
+
+struct LAtlasPage {
+    SDL_Texture* texture;
+
+    //Copy of the page so regions can be moved, streaming textures can not be read back
+    std::vector<Uint32> pixels;
+
+    std::vector<LAtlasShelf> shelves;
+
+    //Top of the unclaimed area below the last shelf
+    int top;
+
+    //Pixels held by live regions
+    int usedPixels;
+};
+
+//Where a sub-image currently lives, ids stay valid when pages are repacked
+struct LAtlasRegion {
+    int page;
+    SDL_Rect rect;
+    bool live;
+};
+
+//Atlas counters
+struct LAtlasStats {
+    int pages;
+    int regions;
+
+    //Live pixels over all page pixels
+    double occupancy;
+
+    //Unused share of the area claimed by shelves
+    double fragmentation;
+};
+
+//Packs images made at runtime into a few large streaming pages so they batch together
+class LRuntimeAtlas {
+    public:
+        //Initializes internal variables
+        LRuntimeAtlas();
+
+        //Frees pages
+        ~LRuntimeAtlas();
+
+        //Copies an ARGB8888 surface into a page, returns region id or -1
+        int insert( SDL_Surface* surface );
+
+        //Frees a region, its space merges with free neighbours
+        void remove( int id );
+
+        //Gets the page texture and rect of a region
+        SDL_Texture* getTexture( int id, SDL_Rect* clip );
+
+        //Repacks pages more fragmented than threshold, returns pages repacked
+        int defragment( double threshold );
+
+        //Gets occupancy and fragmentation
+        LAtlasStats getStats();
+
+        //Frees every page and region
+        void free();
+
+    private:
+        //Claims w by h on a page, false if it does not fit
+        bool allocate( LAtlasPage& page, int w, int h, SDL_Rect* rect );
+
+        //Gives a rect back to its shelf
+        void release( LAtlasPage& page, SDL_Rect rect );
+
+        //Creates an empty page, returns its index or -1
+        int addPage();
+
+        //Gets share of a page's claimed area not holding pixels
+        double getFragmentation( LAtlasPage& page );
+
+        std::vector<LAtlasPage> mPages;
+        std::vector<LAtlasRegion> mRegions;
+
+        //Ids of removed regions for reuse
+        std::vector<int> mFreeIds;
+};
+
+LRuntimeAtlas::LRuntimeAtlas() {
+}
+
+LRuntimeAtlas::~LRuntimeAtlas() {
+    free();
+}
+
+int LRuntimeAtlas::addPage() {
+    LAtlasPage page;
+    page.texture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE );
+    if (page.texture == NULL) {
+        printf("Unable to create atlas page! SDL Error: %s\n", SDL_GetError());
+        return -1;
+    }
+    SDL_SetTextureBlendMode( page.texture, SDL_BLENDMODE_BLEND );
+    page.pixels.assign( ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE, 0 );
+    page.top = 0;
+    page.usedPixels = 0;
+
+    //Start transparent, a streaming texture's first contents are undefined
+    SDL_UpdateTexture( page.texture, NULL, &page.pixels[0], ATLAS_PAGE_SIZE * 4 );
+    mPages.push_back( page );
+    return mPages.size() - 1;
+}
+
+bool LRuntimeAtlas::allocate( LAtlasPage& page, int w, int h, SDL_Rect* rect ) {
+    w += ATLAS_PADDING;
+    h += ATLAS_PADDING;
+
+    //First pass only takes shelves close to this height, second takes any tall enough
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t s = 0; s < page.shelves.size(); s++) {
+            LAtlasShelf& shelf = page.shelves[s];
+            if (shelf.h < h || ( pass == 0 && shelf.h > h + h / 2 ))
+                continue;
+            for (size_t i = 0; i < shelf.freeSpans.size(); i++) {
+                LAtlasSpan& span = shelf.freeSpans[i];
+                if (span.w >= w) {
+                    rect->x = span.x;
+                    rect->y = shelf.y;
+                    span.x += w;
+                    span.w -= w;
+                    if (span.w == 0)
+                        shelf.freeSpans.erase( shelf.freeSpans.begin() + i );
+                    rect->w = w - ATLAS_PADDING;
+                    rect->h = h - ATLAS_PADDING;
+                    return true;
+                }
+            }
+        }
+
+        //Open a new shelf before settling for a much taller one
+        if (pass == 0 && page.top + h <= ATLAS_PAGE_SIZE && w <= ATLAS_PAGE_SIZE) {
+            LAtlasShelf shelf;
+            shelf.y = page.top;
+            shelf.h = h;
+            if (w < ATLAS_PAGE_SIZE) {
+                LAtlasSpan span = { w, ATLAS_PAGE_SIZE - w };
+                shelf.freeSpans.push_back( span );
+            }
+            page.shelves.push_back( shelf );
+            page.top += h;
+            rect->x = 0;
+            rect->y = shelf.y;
+            rect->w = w - ATLAS_PADDING;
+            rect->h = h - ATLAS_PADDING;
+            return true;
+        }
+    }
+    return false;
+}
+
+void LRuntimeAtlas::release( LAtlasPage& page, SDL_Rect rect ) {
+    size_t s = 0;
+    while (s < page.shelves.size() && page.shelves[s].y != rect.y)
+        s++;
+    if (s == page.shelves.size())
+        return;
+    LAtlasShelf& shelf = page.shelves[s];
+
+    //Insert in x order and merge with the spans either side
+    LAtlasSpan freed = { rect.x, rect.w + ATLAS_PADDING };
+    size_t i = 0;
+    while (i < shelf.freeSpans.size() && shelf.freeSpans[i].x < freed.x)
+        i++;
+    shelf.freeSpans.insert( shelf.freeSpans.begin() + i, freed );
+    if (i + 1 < shelf.freeSpans.size() && shelf.freeSpans[i].x + shelf.freeSpans[i].w == shelf.freeSpans[ i + 1 ].x) {
+        shelf.freeSpans[i].w += shelf.freeSpans[ i + 1 ].w;
+        shelf.freeSpans.erase( shelf.freeSpans.begin() + i + 1 );
+    }
+    if (i > 0 && shelf.freeSpans[ i - 1 ].x + shelf.freeSpans[ i - 1 ].w == shelf.freeSpans[i].x) {
+        shelf.freeSpans[ i - 1 ].w += shelf.freeSpans[i].w;
+        shelf.freeSpans.erase( shelf.freeSpans.begin() + i );
+    }
+
+    //Empty shelves at the bottom give their rows back to the page
+    while (!page.shelves.empty()) {
+        LAtlasShelf& last = page.shelves.back();
+        if (last.freeSpans.size() != 1 || last.freeSpans[0].w != ATLAS_PAGE_SIZE)
+            break;
+        page.top = last.y;
+        page.shelves.pop_back();
+    }
+}
+
+int LRuntimeAtlas::insert( SDL_Surface* surface ) {
+    if (surface->w + ATLAS_PADDING > ATLAS_PAGE_SIZE || surface->h + ATLAS_PADDING > ATLAS_PAGE_SIZE) {
+        printf("Image of %dx%d is too big for the atlas!\n", surface->w, surface->h);
+        return -1;
+    }
+
+    //Newest pages first, older ones are usually full
+    SDL_Rect rect;
+    int page = (int) mPages.size() - 1;
+    while (page >= 0 && !allocate( mPages[page], surface->w, surface->h, &rect ))
+        page--;
+    if (page < 0) {
+        page = addPage();
+        if (page < 0 || !allocate( mPages[page], surface->w, surface->h, &rect ))
+            return -1;
+    }
+
+    //Keep the copy and upload just the sub-rect
+    LAtlasPage& target = mPages[page];
+    for (int y = 0; y < rect.h; y++)
+        memcpy( &target.pixels[ ( rect.y + y ) * ATLAS_PAGE_SIZE + rect.x ], (Uint8*) surface->pixels + y * surface->pitch, rect.w * 4 );
+    SDL_UpdateTexture( target.texture, &rect, &target.pixels[ rect.y * ATLAS_PAGE_SIZE + rect.x ], ATLAS_PAGE_SIZE * 4 );
+    target.usedPixels += rect.w * rect.h;
+
+    LAtlasRegion region;
+    region.page = page;
+    region.rect = rect;
+    region.live = true;
+    int id;
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+        mRegions[id] = region;
+    }
+    else {
+        id = mRegions.size();
+        mRegions.push_back( region );
+    }
+    return id;
+}
+
+void LRuntimeAtlas::remove( int id ) {
+    if (id < 0 || id >= (int) mRegions.size() || !mRegions[id].live)
+        return;
+
+    //Pixels are left in place, the next insert overwrites them
+    LAtlasRegion& region = mRegions[id];
+    LAtlasPage& page = mPages[ region.page ];
+    release( page, region.rect );
+    page.usedPixels -= region.rect.w * region.rect.h;
+    region.live = false;
+    mFreeIds.push_back( id );
+}
+
+SDL_Texture* LRuntimeAtlas::getTexture( int id, SDL_Rect* clip ) {
+    LAtlasRegion& region = mRegions[id];
+    *clip = region.rect;
+    return mPages[ region.page ].texture;
+}
+
+double LRuntimeAtlas::getFragmentation( LAtlasPage& page ) {
+    if (page.top == 0)
+        return 0;
+    return 1.0 - (double) page.usedPixels / ( (double) page.top * ATLAS_PAGE_SIZE );
+}
+
+//Orders region ids tallest first so repacked shelves waste little space
+struct LTallerFirst {
+    std::vector<LAtlasRegion>* regions;
+    bool operator()( int a, int b ) {
+        return ( *regions )[a].rect.h > ( *regions )[b].rect.h;
+    }
+};
+
+int LRuntimeAtlas::defragment( double threshold ) {
+    int repacked = 0;
+    for (size_t p = 0; p < mPages.size(); p++) {
+        LAtlasPage& page = mPages[p];
+        if (getFragmentation( page ) <= threshold)
+            continue;
+
+        std::vector<int> ids;
+        for (size_t i = 0; i < mRegions.size(); i++) {
+            if (mRegions[i].live && mRegions[i].page == (int) p)
+                ids.push_back( i );
+        }
+        LTallerFirst tallerFirst;
+        tallerFirst.regions = &mRegions;
+        std::sort( ids.begin(), ids.end(), tallerFirst );
+
+        //Lay everything out again on an empty copy, keeping the old page if it somehow does not fit
+        LAtlasPage packed;
+        packed.texture = page.texture;
+        packed.pixels.assign( ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE, 0 );
+        packed.top = 0;
+        packed.usedPixels = page.usedPixels;
+        std::vector<SDL_Rect> rects( ids.size() );
+        bool fits = true;
+        for (size_t i = 0; i < ids.size() && fits; i++)
+            fits = allocate( packed, mRegions[ ids[i] ].rect.w, mRegions[ ids[i] ].rect.h, &rects[i] );
+        if (!fits)
+            continue;
+
+        for (size_t i = 0; i < ids.size(); i++) {
+            SDL_Rect& from = mRegions[ ids[i] ].rect;
+            for (int y = 0; y < from.h; y++)
+                memcpy( &packed.pixels[ ( rects[i].y + y ) * ATLAS_PAGE_SIZE + rects[i].x ], &page.pixels[ ( from.y + y ) * ATLAS_PAGE_SIZE + from.x ], from.w * 4 );
+            from = rects[i];
+        }
+
+        //One upload of the whole page
+        SDL_UpdateTexture( packed.texture, NULL, &packed.pixels[0], ATLAS_PAGE_SIZE * 4 );
+        page.pixels.swap( packed.pixels );
+        page.shelves.swap( packed.shelves );
+        page.top = packed.top;
+        repacked++;
+    }
+    return repacked;
+}
+
+LAtlasStats LRuntimeAtlas::getStats() {
+    LAtlasStats stats;
+    stats.pages = mPages.size();
+    stats.regions = mRegions.size() - mFreeIds.size();
+
+    double used = 0, claimed = 0;
+    for (size_t p = 0; p < mPages.size(); p++) {
+        used += mPages[p].usedPixels;
+        claimed += (double) mPages[p].top * ATLAS_PAGE_SIZE;
+    }
+    stats.occupancy = mPages.empty() ? 0 : used / ( (double) mPages.size() * ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE );
+    stats.fragmentation = claimed > 0 ? 1.0 - used / claimed : 0;
+    return stats;
+}
+
+void LRuntimeAtlas::free() {
+    for (size_t p = 0; p < mPages.size(); p++)
+        SDL_DestroyTexture( mPages[p].texture );
+    mPages.clear();
+    mRegions.clear();
+    mFreeIds.clear();
+}
+
+//Image made at runtime, in the atlas or as its own texture
+struct LItem {
+    int atlasId;
+    SDL_Texture* texture;
+    int w;
+    int h;
+    int x;
+    int y;
+
+    //Frame the item goes away on
+    int expires;
+};
+
+LRuntimeAtlas gAtlas;
+SDL_Surface* gFooSurface = NULL;
+std::vector<LItem> gItems;
+
+//Makes one of a text label, a tinted sprite or a generated disc
+SDL_Surface* makeImage( int n ) {
+    SDL_Surface* surface = NULL;
+    SDL_Color color = { (Uint8) ( rand() % 200 ), (Uint8) ( rand() % 200 ), (Uint8) ( rand() % 200 ), 0xFF };
+    switch (n % 3) {
+        case 0: {
+            char text[ 32 ];
+            SDL_snprintf( text, sizeof(text), "label %d", n );
+            SDL_Surface* textSurface = TTF_RenderText_Blended( gFont, text, color );
+            if (textSurface != NULL) {
+                surface = SDL_ConvertSurfaceFormat( textSurface, SDL_PIXELFORMAT_ARGB8888, 0 );
+                SDL_FreeSurface( textSurface );
+            }
+            break;
+        }
+
+        case 1: {
+            //Tint baked into the pixels, as a per-variant image would be
+            surface = SDL_ConvertSurfaceFormat( gFooSurface, SDL_PIXELFORMAT_ARGB8888, 0 );
+            if (surface != NULL) {
+                for (int y = 0; y < surface->h; y++) {
+                    Uint32* row = (Uint32*) ( (Uint8*) surface->pixels + y * surface->pitch );
+                    for (int x = 0; x < surface->w; x++) {
+                        Uint32 p = row[x];
+                        Uint32 r = ( ( p >> 16 ) & 0xFF ) * ( color.r + 55 ) / 255;
+                        Uint32 g = ( ( p >> 8 ) & 0xFF ) * ( color.g + 55 ) / 255;
+                        Uint32 b = ( p & 0xFF ) * ( color.b + 55 ) / 255;
+                        row[x] = ( p & 0xFF000000 ) | ( r << 16 ) | ( g << 8 ) | b;
+                    }
+                }
+            }
+            break;
+        }
+
+        default: {
+            int radius = 8 + rand() % 32;
+            surface = SDL_CreateRGBSurfaceWithFormat( 0, radius * 2, radius * 2, 32, SDL_PIXELFORMAT_ARGB8888 );
+            if (surface != NULL) {
+                for (int y = 0; y < surface->h; y++) {
+                    Uint32* row = (Uint32*) ( (Uint8*) surface->pixels + y * surface->pitch );
+                    for (int x = 0; x < surface->w; x++) {
+                        int dx = x - radius, dy = y - radius;
+                        int d2 = dx * dx + dy * dy;
+                        Uint32 alpha = d2 < radius * radius ? 255 - 255 * d2 / ( radius * radius ) : 0;
+                        row[x] = ( alpha << 24 ) | ( color.r << 16 ) | ( color.g << 8 ) | color.b;
+                    }
+                }
+            }
+            break;
+        }
+    }
+    return surface;
+}
+
+//Adds an item, uploading into the atlas or into a texture of its own
+void spawnItem( int n, int frame, bool useAtlas ) {
+    SDL_Surface* surface = makeImage( n );
+    if (surface == NULL)
+        return;
+
+    LItem item;
+    item.atlasId = -1;
+    item.texture = NULL;
+    item.w = surface->w;
+    item.h = surface->h;
+    item.x = rand() % ( SCREEN_WIDTH - item.w / 2 );
+    item.y = rand() % ( SCREEN_HEIGHT - item.h / 2 );
+    item.expires = frame + ITEM_LIFETIME / 2 + rand() % ITEM_LIFETIME;
+    if (useAtlas)
+        item.atlasId = gAtlas.insert( surface );
+    else {
+        item.texture = SDL_CreateTextureFromSurface( gRenderer, surface );
+        if (item.texture != NULL)
+            SDL_SetTextureBlendMode( item.texture, SDL_BLENDMODE_BLEND );
+    }
+    SDL_FreeSurface( surface );
+
+    if (item.atlasId >= 0 || item.texture != NULL)
+        gItems.push_back( item );
+}
+
+//Frees an item's image
+void freeItem( LItem& item ) {
+    if (item.atlasId >= 0)
+        gAtlas.remove( item.atlasId );
+    if (item.texture != NULL)
+        SDL_DestroyTexture( item.texture );
+}
+
+//Spawns, expires and draws items for one frame
+void updateAndRender( int frame, bool useAtlas ) {
+    for (size_t i = 0; i < gItems.size();) {
+        if (gItems[i].expires <= frame) {
+            freeItem( gItems[i] );
+            gItems[i] = gItems.back();
+            gItems.pop_back();
+        }
+        else
+            i++;
+    }
+    for (int i = 0; i < SPAWNS_PER_FRAME && (int) gItems.size() < MAX_ITEMS; i++)
+        spawnItem( frame * SPAWNS_PER_FRAME + i, frame, useAtlas );
+
+    if (useAtlas && frame % DEFRAG_INTERVAL == DEFRAG_INTERVAL - 1)
+        gAtlas.defragment( DEFRAG_THRESHOLD );
+
+    //Clear screen
+    SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+    SDL_RenderClear( gRenderer );
+
+    gLastTexture = NULL;
+    for (size_t i = 0; i < gItems.size(); i++) {
+        LItem& item = gItems[i];
+        SDL_Rect renderQuad = { item.x, item.y, item.w, item.h };
+        if (item.atlasId >= 0) {
+            SDL_Rect clip;
+            SDL_Texture* page = gAtlas.getTexture( item.atlasId, &clip );
+            renderCopy( page, &clip, &renderQuad );
+        }
+        else
+            renderCopy( item.texture, NULL, &renderQuad );
+    }
+
+    //Update screen
+    SDL_RenderPresent( gRenderer );
+}
+
+//Frees every item
+void clearItems() {
+    for (size_t i = 0; i < gItems.size(); i++)
+        freeItem( gItems[i] );
+    gItems.clear();
+}
+
+//Prints atlas occupancy and fragmentation
+void printAtlasStats() {
+    LAtlasStats stats = gAtlas.getStats();
+    printf("%d pages, %d regions, %.1f%% occupied, %.1f%% fragmented\n", stats.pages, stats.regions, stats.occupancy * 100, stats.fragmentation * 100);
+}
+
+//Runs the same churn of images both ways
+void benchmark() {
+    for (int pass = 0; pass < 2; pass++) {
+        bool useAtlas = pass == 1;
+        srand( 1 );
+        gTextureSwitches = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            updateAndRender( frame, useAtlas );
+            SDL_PumpEvents();
+        }
+        double ms = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_FRAMES;
+        printf("%-18s %.3f ms/frame, %.1f texture switches/frame\n", useAtlas ? "runtime atlas" : "own textures", ms, (double) gTextureSwitches / BENCH_FRAMES);
+        if (useAtlas)
+            printAtlasStats();
+        clearItems();
+    }
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    gFont = TTF_OpenFont( "lazy.ttf", 20 );
+    if (gFont == NULL) {
+        printf("Unable to load font SDL Error: %s\n", TTF_GetError());
+        success = false;
+    }
+
+    gFooSurface = IMG_Load( "foo.png" );
+    if (gFooSurface == NULL) {
+        printf("Unable to load foo.png! SDL_image Error: %s\n", IMG_GetError());
+        success = false;
+    }
+    else {
+        //Bake the lessons' cyan color key into alpha
+        SDL_SetColorKey( gFooSurface, SDL_TRUE, SDL_MapRGB( gFooSurface->format, 0, 0xFF, 0xFF ) );
+        SDL_Surface* converted = SDL_ConvertSurfaceFormat( gFooSurface, SDL_PIXELFORMAT_ARGB8888, 0 );
+        SDL_FreeSurface( gFooSurface );
+        gFooSurface = converted;
+        if (gFooSurface == NULL)
+            success = false;
+    }
+    return success;
+}
+
+void close() {
+    clearItems();
+    gAtlas.free();
+    SDL_FreeSurface( gFooSurface );
+    gFooSurface = NULL;
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    TTF_CloseFont(gFont);
+    gFont = NULL;
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize PNG loading
+                int imgFlags = IMG_INIT_PNG;
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            benchmark();
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            bool useAtlas = true;
+            int frame = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Space switches between the atlas and a texture per image
+                    else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE ) {
+                        clearItems();
+                        useAtlas = !useAtlas;
+                        printf("%s\n", useAtlas ? "Runtime atlas" : "Texture per image");
+                    }
+                }
+
+                gTextureSwitches = 0;
+                updateAndRender( frame, useAtlas );
+                if (frame % 60 == 0) {
+                    printf("%d images, %d texture switches: ", (int) gItems.size(), gTextureSwitches);
+                    printAtlasStats();
+                }
+                frame++;
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,475 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Dirty areas are tracked in square tiles of this many pixels
+const int TILE_SIZE = 32;
+
+//Animated patch and paint brush sizes
+const int PLASMA_SIZE = 64;
+const int BRUSH_RADIUS = 6;
+
+const int BENCH_FRAMES = 600;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Fills rect of a locked texture, pixels points at the rect's top left and pitch is in pixels
+typedef void (*LPixelWriter)( SDL_Rect* rect, Uint32* pixels, int pitch, void* userdata );
+
+//Wrapper class for texture
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Creates a blank texture the CPU writes into while running
+        bool createStreaming( int width, int height );
+
+        //Dealocates texture
+        void free();
+
+        //Marks an area to be rewritten on the next update
+        void markDirty( SDL_Rect rect );
+        void markAllDirty();
+
+        //Locks each run of dirty tiles and lets writer fill it in place, returns bytes uploaded
+        int update( LPixelWriter writer, void* userdata );
+
+        //Gets locks taken by the last update
+        int getLastLocks();
+
+        //Renders texture at a given point
+        void render( int x, int y );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+
+        //One flag per tile, row major
+        std::vector<Uint8> mDirtyTiles;
+        int mTilesX;
+        int mTilesY;
+
+        int mLastLocks;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+    mTilesX = 0;
+    mTilesY = 0;
+    mLastLocks = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::createStreaming( int width, int height ) {
+    //Delete the previous texture
+    free();
+
+    //Same format as the pixels written so unlocking uploads without converting
+    mTexture = SDL_CreateTexture( gRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height );
+    if (mTexture == NULL)
+        printf("Unable to create streaming texture! SDL Error: %s\n", SDL_GetError());
+    else {
+        mWidth = width;
+        mHeight = height;
+        mTilesX = ( width + TILE_SIZE - 1 ) / TILE_SIZE;
+        mTilesY = ( height + TILE_SIZE - 1 ) / TILE_SIZE;
+
+        //Contents start undefined, so the first update writes everything
+        mDirtyTiles.assign( mTilesX * mTilesY, 1 );
+    }
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+        mDirtyTiles.clear();
+    }
+}
+
+void LTexture::markDirty( SDL_Rect rect ) {
+    int left = SDL_max( rect.x, 0 ) / TILE_SIZE;
+    int top = SDL_max( rect.y, 0 ) / TILE_SIZE;
+    int right = SDL_min( rect.x + rect.w, mWidth ) - 1;
+    int bottom = SDL_min( rect.y + rect.h, mHeight ) - 1;
+    if (right < 0 || bottom < 0 || rect.w <= 0 || rect.h <= 0)
+        return;
+    for (int ty = top; ty <= bottom / TILE_SIZE; ty++) {
+        for (int tx = left; tx <= right / TILE_SIZE; tx++)
+            mDirtyTiles[ ty * mTilesX + tx ] = 1;
+    }
+}
+
+void LTexture::markAllDirty() {
+    mDirtyTiles.assign( mTilesX * mTilesY, 1 );
+}
+
+int LTexture::update( LPixelWriter writer, void* userdata ) {
+    int bytes = 0;
+    mLastLocks = 0;
+    for (int ty = 0; ty < mTilesY; ty++) {
+        int tx = 0;
+        while (tx < mTilesX) {
+            if (!mDirtyTiles[ ty * mTilesX + tx ]) {
+                tx++;
+                continue;
+            }
+
+            //Neighbouring dirty tiles in a row share one lock
+            int start = tx;
+            while (tx < mTilesX && mDirtyTiles[ ty * mTilesX + tx ]) {
+                mDirtyTiles[ ty * mTilesX + tx ] = 0;
+                tx++;
+            }
+            SDL_Rect rect = { start * TILE_SIZE, ty * TILE_SIZE, 0, 0 };
+            rect.w = SDL_min( tx * TILE_SIZE, mWidth ) - rect.x;
+            rect.h = SDL_min( ( ty + 1 ) * TILE_SIZE, mHeight ) - rect.y;
+
+            //Write straight into the renderer's upload memory, only this rect goes to the GPU
+            void* pixels;
+            int pitch;
+            if (SDL_LockTexture( mTexture, &rect, &pixels, &pitch ) != 0) {
+                printf("Unable to lock texture! SDL Error: %s\n", SDL_GetError());
+                continue;
+            }
+            writer( &rect, (Uint32*) pixels, pitch / 4, userdata );
+            SDL_UnlockTexture( mTexture );
+            bytes += rect.w * rect.h * 4;
+            mLastLocks++;
+        }
+    }
+    return bytes;
+}
+
+int LTexture::getLastLocks() {
+    return mLastLocks;
+}
+
+void LTexture::render( int x, int y ) {
+    SDL_Rect renderquad = { x, y, mWidth, mHeight };
+    SDL_RenderCopy( gRenderer, mTexture, NULL, &renderquad );
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+//Everything the CPU composes into the canvas
+struct LCanvas {
+    //colors.png in ARGB8888, tiled over the canvas and tinted in software
+    SDL_Surface* source;
+    Uint8 r;
+    Uint8 g;
+    Uint8 b;
+
+    //Painted pixels, 0 where nothing was painted
+    std::vector<Uint32> paint;
+
+    //Animated patch position and time
+    SDL_Rect plasma;
+    double time;
+};
+
+LTexture gCanvasTexture;
+LCanvas gCanvas;
+
+//Composes tinted image, paint and plasma for one rect
+void writeCanvas( SDL_Rect* rect, Uint32* pixels, int pitch, void* userdata ) {
+    LCanvas* canvas = (LCanvas*) userdata;
+    SDL_Surface* source = canvas->source;
+    for (int y = 0; y < rect->h; y++) {
+        int sy = rect->y + y;
+        Uint32* row = pixels + y * pitch;
+        Uint32* sourceRow = (Uint32*) ( (Uint8*) source->pixels + ( sy % source->h ) * source->pitch );
+        Uint32* paintRow = &canvas->paint[ sy * SCREEN_WIDTH ];
+        for (int x = 0; x < rect->w; x++) {
+            int sx = rect->x + x;
+            if (sx >= canvas->plasma.x && sx < canvas->plasma.x + canvas->plasma.w && sy >= canvas->plasma.y && sy < canvas->plasma.y + canvas->plasma.h) {
+                double v = sin( sx * 0.11 + canvas->time ) + sin( sy * 0.07 - canvas->time * 1.3 ) + sin( ( sx + sy ) * 0.05 + canvas->time * 0.7 );
+                Uint32 c = (Uint32) ( ( v + 3 ) * 42 );
+                row[x] = 0xFF000000 | ( c << 16 ) | ( ( 255 - c ) << 8 ) | ( c / 2 + 64 );
+            }
+            else if (paintRow[sx] != 0)
+                row[x] = paintRow[sx];
+            else {
+                //Same tint 12-ColorMod asks the renderer for, done here per pixel
+                Uint32 p = sourceRow[ sx % source->w ];
+                Uint32 r = ( ( p >> 16 ) & 0xFF ) * canvas->r / 255;
+                Uint32 g = ( ( p >> 8 ) & 0xFF ) * canvas->g / 255;
+                Uint32 b = ( p & 0xFF ) * canvas->b / 255;
+                row[x] = 0xFF000000 | ( r << 16 ) | ( g << 8 ) | b;
+            }
+        }
+    }
+}
+
+//Moves the plasma patch along a loop, dirtying where it was and where it is
+void animatePlasma( double time ) {
+    gCanvasTexture.markDirty( gCanvas.plasma );
+    gCanvas.time = time;
+    gCanvas.plasma.x = (int) ( ( SCREEN_WIDTH - PLASMA_SIZE ) / 2 * ( 1 + cos( time * 0.5 ) ) );
+    gCanvas.plasma.y = (int) ( ( SCREEN_HEIGHT - PLASMA_SIZE ) / 2 * ( 1 + sin( time * 0.8 ) ) );
+    gCanvasTexture.markDirty( gCanvas.plasma );
+}
+
+//Paints a dot and dirties only the tiles under it
+void paintAt( int x, int y, Uint32 color ) {
+    for (int dy = -BRUSH_RADIUS; dy <= BRUSH_RADIUS; dy++) {
+        for (int dx = -BRUSH_RADIUS; dx <= BRUSH_RADIUS; dx++) {
+            int px = x + dx, py = y + dy;
+            if (dx * dx + dy * dy <= BRUSH_RADIUS * BRUSH_RADIUS && px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT)
+                gCanvas.paint[ py * SCREEN_WIDTH + px ] = color;
+        }
+    }
+    SDL_Rect brush = { x - BRUSH_RADIUS, y - BRUSH_RADIUS, BRUSH_RADIUS * 2 + 1, BRUSH_RADIUS * 2 + 1 };
+    gCanvasTexture.markDirty( brush );
+}
+
+//Sets software tint, every pixel of the image changes
+void setTint( Uint8 r, Uint8 g, Uint8 b ) {
+    if (r != gCanvas.r || g != gCanvas.g || b != gCanvas.b) {
+        gCanvas.r = r;
+        gCanvas.g = g;
+        gCanvas.b = b;
+        gCanvasTexture.markAllDirty();
+    }
+}
+
+//Runs the same animation uploading dirty tiles or the whole canvas each frame
+void benchmark() {
+    for (int pass = 0; pass < 2; pass++) {
+        bool everything = pass == 1;
+        double bytes = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+            animatePlasma( frame / 60.0 );
+            if (frame % 60 == 59)
+                setTint( 0xFF, (Uint8) ( 0xFF - frame % 256 ), 0xFF );
+            paintAt( frame % SCREEN_WIDTH, SCREEN_HEIGHT / 2, 0xFF202020 );
+            if (everything)
+                gCanvasTexture.markAllDirty();
+            bytes += gCanvasTexture.update( writeCanvas, &gCanvas );
+
+            SDL_RenderClear( gRenderer );
+            gCanvasTexture.render( 0, 0 );
+            SDL_RenderPresent( gRenderer );
+            SDL_PumpEvents();
+        }
+        double seconds = ( SDL_GetPerformanceCounter() - start ) / (double) SDL_GetPerformanceFrequency();
+        printf("%-13s %.3f ms/frame, %.1f KB uploaded/frame, %.1f MB/s\n", everything ? "full upload" : "dirty tiles",
+            seconds * 1000 / BENCH_FRAMES, bytes / 1024 / BENCH_FRAMES, bytes / ( 1024 * 1024 ) / seconds);
+    }
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    SDL_Surface* loadedSurface = IMG_Load( "colors.png" );
+    if (loadedSurface == NULL) {
+        printf("Unable to load colors.png! SDL_image Error: %s\n", IMG_GetError());
+        success = false;
+    }
+    else {
+        //Read by the CPU every update, so convert once to the texture's format
+        gCanvas.source = SDL_ConvertSurfaceFormat( loadedSurface, SDL_PIXELFORMAT_ARGB8888, 0 );
+        SDL_FreeSurface( loadedSurface );
+        if (gCanvas.source == NULL) {
+            printf("Unable to convert colors.png! SDL Error: %s\n", SDL_GetError());
+            success = false;
+        }
+    }
+
+    if (!gCanvasTexture.createStreaming( SCREEN_WIDTH, SCREEN_HEIGHT ))
+        success = false;
+
+    gCanvas.r = 0xFF;
+    gCanvas.g = 0xFF;
+    gCanvas.b = 0xFF;
+    gCanvas.paint.assign( SCREEN_WIDTH * SCREEN_HEIGHT, 0 );
+    SDL_Rect plasma = { 0, 0, PLASMA_SIZE, PLASMA_SIZE };
+    gCanvas.plasma = plasma;
+    gCanvas.time = 0;
+    return success;
+}
+
+void close() {
+    gCanvasTexture.free();
+    SDL_FreeSurface( gCanvas.source );
+    gCanvas.source = NULL;
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize PNG loading
+                int imgFlags = IMG_INIT_PNG;
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (bench) {
+            benchmark();
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            Uint8 r = 255;
+            Uint8 g = 255;
+            Uint8 b = 255;
+            bool painting = false;
+            int frame = 0;
+            double uploaded = 0;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //SDL_Quit event is pressing X
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                    else if ( e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP ) {
+                        painting = e.type == SDL_MOUSEBUTTONDOWN;
+                        if (painting)
+                            paintAt( e.button.x, e.button.y, 0xFF000000 );
+                    }
+                    else if ( e.type == SDL_MOUSEMOTION && painting ) {
+                        paintAt( e.motion.x, e.motion.y, 0xFF000000 );
+                    }
+                    else if ( e.type == SDL_KEYDOWN ) {
+                        switch(e.key.keysym.sym) {
+                            //Increase red
+                            case SDLK_q:
+                            r += 32;
+                            break;
+
+                            //Increase green
+                            case SDLK_w:
+                            g += 32;
+                            break;
+
+                            //Increase blue
+                            case SDLK_e:
+                            b += 32;
+                            break;
+
+                            //Decrease red
+                            case SDLK_a:
+                            r -= 32;
+                            break;
+
+                            //Decrease green
+                            case SDLK_s:
+                            g -= 32;
+                            break;
+
+                            //Decrease blue
+                            case SDLK_d:
+                            b -= 32;
+                            break;
+                        }
+                    }
+                }
+                setTint( r, g, b );
+                animatePlasma( frame / 60.0 );
+
+                //Only tiles touched since last frame are written and uploaded
+                uploaded += gCanvasTexture.update( writeCanvas, &gCanvas );
+                frame++;
+                if (frame % 60 == 0) {
+                    printf("Uploaded %.1f KB/frame of %.1f KB, %d locks last frame\n", uploaded / 1024 / 60,
+                        gCanvasTexture.getWidth() * gCanvasTexture.getHeight() * 4 / 1024.0, gCanvasTexture.getLastLocks());
+                    uploaded = 0;
+                }
+
+                //Clear Screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                gCanvasTexture.render( 0, 0 );
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <SDL2/SDL.h>
+#include <string>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+//Compiled for SSSE3 on its own and only called when the CPU has it
+#define FASTBMP_SSSE3
+#include <tmmintrin.h>
+#endif
+
+enum KeyPressSurfaces {
+    KEY_PRESS_SURFACE_DEFAULT,
+    KEY_PRESS_SURFACE_UP,
+    KEY_PRESS_SURFACE_DOWN,
+    KEY_PRESS_SURFACE_LEFT,
+    KEY_PRESS_SURFACE_RIGHT,
+    KEY_PRESS_SURFACE_TOTAL
+};
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+
+//Benchmark images are this big and loaded this many times each way
+const int BENCH_SIZE = 4096;
+const int BENCH_RUNS = 5;
+
+//BMP compression types
+const Uint32 BMP_RGB = 0;
+const Uint32 BMP_BITFIELDS = 3;
+
+SDL_Window* gWindow = NULL;
+SDL_Surface* gScreenSurface = NULL;
+SDL_Surface* gKeyPressSurfaces[ KEY_PRESS_SURFACE_TOTAL ];
+SDL_Surface* gCurrentSurface = NULL;
+bool gHasSSSE3 = false;
+
+//Byte of each channel inside a source pixel, -1 if it has none
+struct LPixelLayout {
+    int bytesPerPixel;
+    int red;
+    int green;
+    int blue;
+    int alpha;
+};
+
+Uint16 readLE16( const Uint8* data ) {
+    return data[0] | ( data[1] << 8 );
+}
+
+Uint32 readLE32( const Uint8* data ) {
+    return data[0] | ( data[1] << 8 ) | ( data[2] << 16 ) | ( (Uint32) data[3] << 24 );
+}
+
+//Gets which byte a mask covers, -1 if it is not exactly one byte
+int maskToByte( Uint32 mask ) {
+    for (int i = 0; i < 4; i++) {
+        if (mask == 0xFFu << ( i * 8 ))
+            return i;
+    }
+    return -1;
+}
+
+//Converts pixels one at a time, works for any 8-bit per channel 32-bit destination
+void convertRowScalar( const Uint8* source, Uint32* destination, int start, int width, LPixelLayout& layout, SDL_PixelFormat* format ) {
+    for (int x = start; x < width; x++) {
+        const Uint8* pixel = source + x * layout.bytesPerPixel;
+        Uint32 value = ( (Uint32) pixel[ layout.red ] << format->Rshift ) | ( (Uint32) pixel[ layout.green ] << format->Gshift ) | ( (Uint32) pixel[ layout.blue ] << format->Bshift );
+        if (format->Amask != 0)
+            value |= (Uint32) ( layout.alpha >= 0 ? pixel[ layout.alpha ] : 0xFF ) << format->Ashift;
+        destination[x] = value;
+    }
+}
+
+#if defined(FASTBMP_SSSE3)
+//Reorders 4 pixels per shuffle, returns how many pixels it converted
+__attribute__(( target( "ssse3" ) ))
+int convertRowSSSE3( const Uint8* source, Uint32* destination, int width, int bytesPerPixel, const Uint8* shuffle, Uint32 fill ) {
+    __m128i mask = _mm_loadu_si128( (const __m128i*) shuffle );
+    __m128i alpha = _mm_set1_epi32( fill );
+
+    //Each load reads 16 bytes, stop before one would run past the row
+    int x = 0;
+    for (; x * bytesPerPixel + 16 <= width * bytesPerPixel; x += 4) {
+        __m128i pixels = _mm_loadu_si128( (const __m128i*) ( source + x * bytesPerPixel ) );
+        _mm_storeu_si128( (__m128i*) ( destination + x ), _mm_or_si128( _mm_shuffle_epi8( pixels, mask ), alpha ) );
+    }
+    return x;
+}
+#endif
+
+//Converts one row of 24 or 32-bit pixels straight into the destination format
+void convertRow( const Uint8* source, Uint32* destination, int width, LPixelLayout& layout, SDL_PixelFormat* format ) {
+    int x = 0;
+
+#if defined(FASTBMP_SSSE3)
+    //Byte-aligned destinations are a byte shuffle, x86 stores pixels little endian
+    if (gHasSSSE3) {
+        Uint8 shuffle[ 16 ];
+        Uint32 fill = 0;
+        for (int i = 0; i < 16; i++)
+            shuffle[i] = 0x80;
+        int sourceBytes[ 4 ] = { layout.red, layout.green, layout.blue, layout.alpha };
+        int shifts[ 4 ] = { format->Rshift, format->Gshift, format->Bshift, format->Ashift };
+        for (int channel = 0; channel < 4; channel++) {
+            if (channel == 3 && format->Amask == 0)
+                continue;
+            if (sourceBytes[channel] < 0) {
+                fill |= 0xFFu << shifts[channel];
+                continue;
+            }
+            for (int pixel = 0; pixel < 4; pixel++)
+                shuffle[ pixel * 4 + shifts[channel] / 8 ] = pixel * layout.bytesPerPixel + sourceBytes[channel];
+        }
+        x = convertRowSSSE3( source, destination, width, layout.bytesPerPixel, shuffle, fill );
+    }
+#endif
+
+    //Remaining pixels, or all of them without SSSE3
+    convertRowScalar( source, destination, x, width, layout, format );
+}
+
+//Two passes the way 05-OptimizedLoad does it, used for anything the fast path skips
+SDL_Surface* loadBMPWithConvert( std::string path, SDL_PixelFormat* format ) {
+    SDL_Surface* optimizedSurface = NULL;
+    SDL_Surface* loadedSurface = SDL_LoadBMP( path.c_str() );
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", SDL_GetError() );
+    else {
+        optimizedSurface = SDL_ConvertSurface( loadedSurface, format, 0 );
+        if (optimizedSurface == NULL)
+            printf("Cannot optimize image! SDL Error:%s\n", SDL_GetError());
+        SDL_FreeSurface(loadedSurface);
+    }
+    return optimizedSurface;
+}
+
+//Maps a BMP and writes its rows into a surface of format in one pass, flipping bottom-up files as it goes
+SDL_Surface* loadBMPFast( std::string path, SDL_PixelFormat* format ) {
+    //Destination must take 8 bits a channel in 32-bit pixels
+    if (format->BytesPerPixel != 4 || format->Rloss != 0 || format->Gloss != 0 || format->Bloss != 0 || ( format->Amask != 0 && format->Aloss != 0 ))
+        return loadBMPWithConvert( path, format );
+
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file < 0) {
+        printf("Unable to open %s!\n", path.c_str());
+        return NULL;
+    }
+    struct stat info;
+    if (fstat( file, &info ) < 0 || info.st_size < 54) {
+        printf("%s is too short to be a BMP!\n", path.c_str());
+        ::close( file );
+        return NULL;
+    }
+
+    //Mapping stays valid after the descriptor is closed
+    void* mapping = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+    ::close( file );
+    if (mapping == MAP_FAILED) {
+        printf("Unable to map %s!\n", path.c_str());
+        return NULL;
+    }
+    const Uint8* data = (const Uint8*) mapping;
+    size_t size = info.st_size;
+
+    //File header then a BITMAPINFOHEADER or one of its longer versions
+    Uint32 pixelOffset = readLE32( data + 10 );
+    Uint32 headerSize = readLE32( data + 14 );
+    int width = (Sint32) readLE32( data + 18 );
+    int height = (Sint32) readLE32( data + 22 );
+    int bitsPerPixel = readLE16( data + 28 );
+    Uint32 compression = readLE32( data + 30 );
+    Uint32 paletteCount = readLE32( data + 46 );
+
+    //Negative height means rows are stored top-down
+    bool bottomUp = height > 0;
+    if (height < 0)
+        height = -height;
+
+    LPixelLayout layout = { bitsPerPixel / 8, 2, 1, 0, -1 };
+    bool supported = data[0] == 'B' && data[1] == 'M' && headerSize >= 40 && width > 0 && height > 0;
+    if (supported && bitsPerPixel == 32 && compression == BMP_BITFIELDS && 14 + 40 + 12 <= size) {
+        //Masks follow the 40-byte header, alpha only when the header is long enough to hold one
+        layout.red = maskToByte( readLE32( data + 54 ) );
+        layout.green = maskToByte( readLE32( data + 58 ) );
+        layout.blue = maskToByte( readLE32( data + 62 ) );
+        Uint32 alphaMask = headerSize >= 56 && 14 + 56 <= size ? readLE32( data + 66 ) : 0;
+        layout.alpha = alphaMask != 0 ? maskToByte( alphaMask ) : -1;
+        supported = layout.red >= 0 && layout.green >= 0 && layout.blue >= 0 && ( alphaMask == 0 || layout.alpha >= 0 );
+    }
+    else if (supported && ( bitsPerPixel == 1 || bitsPerPixel == 4 || bitsPerPixel == 8 ) && compression == BMP_RGB) {
+        if (paletteCount == 0 || paletteCount > ( 1u << bitsPerPixel ))
+            paletteCount = 1u << bitsPerPixel;
+        supported = 14 + headerSize + paletteCount * 4 <= size;
+    }
+    else if (!( bitsPerPixel == 24 || bitsPerPixel == 32 ) || compression != BMP_RGB) {
+        //32-bit BI_RGB is left here too, its fourth byte is unused by the format
+        supported = false;
+    }
+
+    //Rows are padded to 4 bytes
+    size_t rowBytes = ( ( (size_t) width * bitsPerPixel + 31 ) / 32 ) * 4;
+    if (supported && pixelOffset + rowBytes * height > size)
+        supported = false;
+
+    //RLE, 16-bit and odd masks take the slow path
+    if (!supported) {
+        munmap( mapping, size );
+        return loadBMPWithConvert( path, format );
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat( 0, width, height, format->BitsPerPixel, format->format );
+    if (surface == NULL) {
+        printf("Unable to create surface for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        munmap( mapping, size );
+        return NULL;
+    }
+
+    //Palette entries become destination pixels once, rows are then a lookup
+    Uint32 palette[ 256 ];
+    if (bitsPerPixel <= 8) {
+        const Uint8* entries = data + 14 + headerSize;
+        LPixelLayout entryLayout = { 4, 2, 1, 0, -1 };
+        memset( palette, 0, sizeof( palette ) );
+        convertRowScalar( entries, palette, 0, paletteCount, entryLayout, format );
+    }
+
+    for (int y = 0; y < height; y++) {
+        const Uint8* source = data + pixelOffset + rowBytes * ( bottomUp ? height - 1 - y : y );
+        Uint32* destination = (Uint32*) ( (Uint8*) surface->pixels + y * surface->pitch );
+        if (bitsPerPixel >= 24)
+            convertRow( source, destination, width, layout, format );
+        else if (bitsPerPixel == 8) {
+            for (int x = 0; x < width; x++)
+                destination[x] = palette[ source[x] ];
+        }
+        else {
+            //Packed indices, leftmost pixel in the high bits
+            int perByte = 8 / bitsPerPixel;
+            Uint8 mask = ( 1 << bitsPerPixel ) - 1;
+            for (int x = 0; x < width; x++) {
+                int shift = ( perByte - 1 - x % perByte ) * bitsPerPixel;
+                destination[x] = palette[ ( source[ x / perByte ] >> shift ) & mask ];
+            }
+        }
+    }
+
+    munmap( mapping, size );
+    return surface;
+}
+
+//Load image and return surface (Optimized)
+SDL_Surface* loadSurface( std::string path ) {
+    SDL_Surface* optimizedSurface = loadBMPFast( path, gScreenSurface->format );
+    if (optimizedSurface == NULL)
+        printf("Unable to load %s!\n", path.c_str());
+    return optimizedSurface;
+}
+
+//Writes a large test image, palettized when bitsPerPixel is 8
+bool writeBenchImage( std::string path, int bitsPerPixel ) {
+    Uint32 pixelFormat = bitsPerPixel == 8 ? SDL_PIXELFORMAT_INDEX8 : ( bitsPerPixel == 24 ? SDL_PIXELFORMAT_BGR24 : SDL_PIXELFORMAT_ARGB8888 );
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat( 0, BENCH_SIZE, BENCH_SIZE, bitsPerPixel, pixelFormat );
+    if (surface == NULL)
+        return false;
+
+    if (bitsPerPixel == 8) {
+        SDL_Color colors[ 256 ];
+        for (int i = 0; i < 256; i++) {
+            colors[i].r = i;
+            colors[i].g = 255 - i;
+            colors[i].b = i * 7;
+            colors[i].a = 0xFF;
+        }
+        SDL_SetPaletteColors( surface->format->palette, colors, 0, 256 );
+    }
+
+    //Gradients with some noise so no row is like the next
+    for (int y = 0; y < BENCH_SIZE; y++) {
+        Uint8* row = (Uint8*) surface->pixels + y * surface->pitch;
+        for (int x = 0; x < BENCH_SIZE * surface->format->BytesPerPixel; x++)
+            row[x] = (Uint8) ( x + y * 3 + ( ( x * y ) >> 5 ) );
+    }
+    bool success = SDL_SaveBMP( surface, path.c_str() ) == 0;
+    SDL_FreeSurface( surface );
+    return success;
+}
+
+//Counts pixels that differ, ignoring alpha when the format has none
+int countDifferences( SDL_Surface* a, SDL_Surface* b ) {
+    if (a == NULL || b == NULL || a->w != b->w || a->h != b->h)
+        return -1;
+    Uint32 mask = a->format->Rmask | a->format->Gmask | a->format->Bmask | a->format->Amask;
+    int differences = 0;
+    for (int y = 0; y < a->h; y++) {
+        Uint32* rowA = (Uint32*) ( (Uint8*) a->pixels + y * a->pitch );
+        Uint32* rowB = (Uint32*) ( (Uint8*) b->pixels + y * b->pitch );
+        for (int x = 0; x < a->w; x++) {
+            if (( rowA[x] & mask ) != ( rowB[x] & mask ))
+                differences++;
+        }
+    }
+    return differences;
+}
+
+//Loads a file both ways into format and returns ms per load
+void timeLoads( std::string path, SDL_PixelFormat* format, double* convertMs, double* fastMs, int* differences ) {
+    SDL_Surface* converted = NULL;
+    SDL_Surface* fast = NULL;
+    Uint64 convertTicks = 0, fastTicks = 0;
+    for (int i = 0; i < BENCH_RUNS; i++) {
+        SDL_FreeSurface( converted );
+        SDL_FreeSurface( fast );
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        converted = loadBMPWithConvert( path, format );
+        convertTicks += SDL_GetPerformanceCounter() - start;
+
+        start = SDL_GetPerformanceCounter();
+        fast = loadBMPFast( path, format );
+        fastTicks += SDL_GetPerformanceCounter() - start;
+    }
+    *convertMs = convertTicks * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_RUNS;
+    *fastMs = fastTicks * 1000.0 / SDL_GetPerformanceFrequency() / BENCH_RUNS;
+    *differences = countDifferences( converted, fast );
+    SDL_FreeSurface( converted );
+    SDL_FreeSurface( fast );
+}
+
+void benchmark() {
+    //Destination is the window's format, same as the lesson's loads
+    SDL_PixelFormat* format = gScreenSurface->format;
+    printf("%dx%d BMPs into %s, SSSE3 %s\n", BENCH_SIZE, BENCH_SIZE, SDL_GetPixelFormatName( format->format ), gHasSSSE3 ? "on" : "off");
+    printf("        LoadBMP+Convert    fast loader   speedup\n");
+
+    int depths[ 3 ] = { 24, 32, 8 };
+    for (int i = 0; i < 3; i++) {
+        char path[ 32 ];
+        SDL_snprintf( path, sizeof(path), "bench%d.bmp", depths[i] );
+        if (!writeBenchImage( path, depths[i] )) {
+            printf("Unable to write %s! SDL Error: %s\n", path, SDL_GetError());
+            continue;
+        }
+
+        double convertMs, fastMs;
+        int differences;
+        timeLoads( path, format, &convertMs, &fastMs, &differences );
+        printf("%2d-bit %12.3f ms %12.3f ms %8.2fx  %s\n", depths[i], convertMs, fastMs, convertMs / fastMs, differences == 0 ? "same pixels" : "PIXELS DIFFER");
+        remove( path );
+    }
+}
+
+//Initialize SDL Video Plugin and Window
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gHasSSSE3 = SDL_HasSSSE3();
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL){
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            gScreenSurface = SDL_GetWindowSurface( gWindow );
+        }
+    }
+    return success;
+}
+
+bool loadMedia() {
+    bool success = true;
+    const char* paths[ KEY_PRESS_SURFACE_TOTAL ] = { "images/press.bmp", "images/up.bmp", "images/down.bmp", "images/left.bmp", "images/right.bmp" };
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+        gKeyPressSurfaces[i] = loadSurface( paths[i] );
+        if (gKeyPressSurfaces[i] == NULL)
+            success = false;
+    }
+    printf("Loaded %d images in %.3f ms\n", KEY_PRESS_SURFACE_TOTAL, ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency());
+
+    return success;
+}
+
+
+//Free up Resources
+void close() {
+    for (int i = 0; i < KEY_PRESS_SURFACE_TOTAL; i++) {
+        SDL_FreeSurface( gKeyPressSurfaces[i] );
+        gKeyPressSurfaces[i] = NULL;
+    }
+    gCurrentSurface = NULL;
+
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+
+    SDL_Quit();
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else if (argc > 1 && strcmp( args[1], "--bench" ) == 0) {
+        benchmark();
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;//Main flag
+            SDL_Event e; //Variable to Store Event
+            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_DEFAULT ]; //Initial Surface is default
+            //SDL Rect to denote the final scaling of blitted image
+            SDL_Rect stretchRect;
+            stretchRect.x = SCREEN_WIDTH/8;
+            stretchRect.y = SCREEN_HEIGHT/8;
+            stretchRect.w = 2*SCREEN_WIDTH/3;
+            stretchRect.h = 2*SCREEN_HEIGHT/3;
+
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //SDL_Quit event is pressing X
+                    if (e.type == SDL_QUIT)
+                        quit = true;
+                    //SDL key press event
+                    else if (e.type == SDL_KEYDOWN) {
+                        //Switch over all the keys
+                        switch(e.key.keysym.sym) {
+                            case SDLK_UP:
+                            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_UP ];
+                            break;
+                            case SDLK_DOWN:
+                            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_DOWN ];
+                            break;
+                            case SDLK_LEFT:
+                            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_LEFT ];
+                            break;
+                            case SDLK_RIGHT:
+                            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_RIGHT ];
+                            break;
+                            case SDLK_ESCAPE:
+                            quit = true;
+                            break;
+                            default:
+                            gCurrentSurface = gKeyPressSurfaces[ KEY_PRESS_SURFACE_DEFAULT ];
+                            break;
+                        }
+                    }
+                }
+                //Blit transfers copy of src surface to dest surface
+                SDL_BlitScaled(gCurrentSurface, NULL, gScreenSurface, &stretchRect);
+                SDL_UpdateWindowSurface(gWindow);
+            }
+        }
+    }
+    close();
+    return 0;
+}
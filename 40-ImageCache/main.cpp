@@ -0,0 +1,547 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_IMAGES = 11;
+const char* gImageFiles[ TOTAL_IMAGES ] = { "loaded.png", "texture.png", "dots.png", "foo.png", "background.png", "colors.png",
+    "button.png", "arrow.png", "fadein.png", "fadeout.png", "viewport.png" };
+const int BENCH_RUNS = 10;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+//Cache file layout: LImageCacheHeader, then pitch * height bytes of pixels
+const Uint32 IMAGE_CACHE_MAGIC = 0x434D494C; //"LIMC"
+const Uint32 IMAGE_CACHE_VERSION = 1;
+const char* IMAGE_CACHE_DIRECTORY = "cache";
+
+struct LImageCacheHeader {
+    Uint32 magic;
+    Uint32 version;
+
+    //SDL_PixelFormatEnum the pixels were converted to
+    Uint32 format;
+
+    //Image dimensions and bytes per row
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;
+
+    //Source file as it was when the pixels were made
+    Uint64 sourceSize;
+    Sint64 sourceSeconds;
+    Sint64 sourceNanoseconds;
+    Uint64 sourceHash;
+
+    //Pads the header so pixels start on a cache line
+    Uint64 reserved;
+};
+
+//Decoded and converted images kept on disk between launches
+class LImageCache {
+    public:
+        //Initializes internal variables
+        LImageCache();
+
+        //Sets the format cached pixels are converted to, caches of other formats are ignored
+        void setFormat( Uint32 format );
+
+        //Gets a texture for an image, from the cache when it is still valid
+        SDL_Texture* loadTexture( std::string path, int* width, int* height );
+
+        //Deletes the cache file of an image for this format
+        void remove( std::string path );
+
+        //Prints hit, revalidation and miss counts
+        void printStats();
+
+    private:
+        //Gets the cache file name for an image in this format
+        std::string getCachePath( std::string path );
+
+        //Decodes, converts and writes a new cache file, returns the converted surface
+        SDL_Surface* rebuild( std::string path, std::vector<Uint8>& contents, Uint64 hash, struct stat* source );
+
+        Uint32 mFormat;
+        int mHits;
+        int mRevalidated;
+        int mMisses;
+};
+
+//Reads a whole file, false if it can't be read
+bool readFile( std::string path, std::vector<Uint8>& contents ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL)
+        return false;
+
+    Sint64 size = SDL_RWsize( file );
+    bool success = size >= 0;
+    if (success) {
+        contents.resize( size );
+        success = size == 0 || SDL_RWread( file, contents.data(), size, 1 ) == 1;
+    }
+    SDL_RWclose( file );
+    return success;
+}
+
+//64-bit FNV-1a over the file bytes, length folded in to separate prefixes
+Uint64 hashContents( std::vector<Uint8>& contents ) {
+    Uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < contents.size(); i++) {
+        hash ^= contents[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ contents.size();
+}
+
+LImageCache::LImageCache() {
+    mFormat = SDL_PIXELFORMAT_ARGB8888;
+    mHits = 0;
+    mRevalidated = 0;
+    mMisses = 0;
+}
+
+void LImageCache::setFormat( Uint32 format ) {
+    mFormat = format;
+}
+
+std::string LImageCache::getCachePath( std::string path ) {
+    //Hash of the full path keeps same-named images from different folders apart
+    char* resolved = realpath( path.c_str(), NULL );
+    std::vector<Uint8> location( path.begin(), path.end() );
+    if (resolved != NULL) {
+        location.assign( resolved, resolved + strlen( resolved ) );
+        ::free( resolved );
+    }
+
+    //Format is in the name, so moving between displays keeps both caches warm
+    char suffix[ 48 ];
+    SDL_snprintf( suffix, sizeof(suffix), ".%016llx.%08x.img", (unsigned long long) hashContents( location ), mFormat );
+    std::string name = path.substr( path.find_last_of( '/' ) + 1 );
+    return std::string( IMAGE_CACHE_DIRECTORY ) + "/" + name + suffix;
+}
+
+SDL_Surface* LImageCache::rebuild( std::string path, std::vector<Uint8>& contents, Uint64 hash, struct stat* source ) {
+    SDL_Surface* convertedSurface = NULL;
+
+    //Decode straight from the bytes we already hashed
+    SDL_Surface* loadedSurface = IMG_Load_RW( SDL_RWFromConstMem( contents.data(), contents.size() ), 1 );
+    if ( loadedSurface == NULL ) {
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+        return NULL;
+    }
+
+    //Bake the lessons' cyan color key into alpha
+    SDL_SetColorKey( loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ) );
+    convertedSurface = SDL_ConvertSurfaceFormat( loadedSurface, mFormat, 0 );
+    SDL_FreeSurface( loadedSurface );
+    if (convertedSurface == NULL) {
+        printf("Unable to convert %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        return NULL;
+    }
+
+    LImageCacheHeader header;
+    memset( &header, 0, sizeof( header ) );
+    header.magic = IMAGE_CACHE_MAGIC;
+    header.version = IMAGE_CACHE_VERSION;
+    header.format = mFormat;
+    header.width = convertedSurface->w;
+    header.height = convertedSurface->h;
+    header.pitch = convertedSurface->pitch;
+    header.sourceSize = source->st_size;
+    header.sourceSeconds = source->st_mtim.tv_sec;
+    header.sourceNanoseconds = source->st_mtim.tv_nsec;
+    header.sourceHash = hash;
+
+    //Write under a temporary name and rename, a crash never leaves half a cache file
+    mkdir( IMAGE_CACHE_DIRECTORY, 0755 );
+    std::string cachePath = getCachePath( path );
+    std::string temporaryPath = cachePath + ".tmp";
+    FILE* file = fopen( temporaryPath.c_str(), "wb" );
+    if (file == NULL)
+        printf("Unable to write cache for %s!\n", path.c_str());
+    else {
+        bool written = fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+            fwrite( convertedSurface->pixels, convertedSurface->pitch, convertedSurface->h, file ) == (size_t) convertedSurface->h;
+        if (fclose( file ) != 0 || !written || rename( temporaryPath.c_str(), cachePath.c_str() ) != 0) {
+            printf("Unable to write cache for %s!\n", path.c_str());
+            unlink( temporaryPath.c_str() );
+        }
+    }
+    return convertedSurface;
+}
+
+SDL_Texture* LImageCache::loadTexture( std::string path, int* width, int* height ) {
+    struct stat source;
+    if (stat( path.c_str(), &source ) < 0) {
+        printf("Unable to find %s!\n", path.c_str());
+        return NULL;
+    }
+
+    //Map the cache file if there is one for this format
+    std::string cachePath = getCachePath( path );
+    Uint8* mapping = NULL;
+    size_t mappingSize = 0;
+    LImageCacheHeader* header = NULL;
+    int file = ::open( cachePath.c_str(), O_RDWR );
+    if (file >= 0) {
+        struct stat info;
+        if (fstat( file, &info ) == 0 && (size_t) info.st_size >= sizeof( LImageCacheHeader )) {
+            void* data = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+            if (data != MAP_FAILED) {
+                mapping = (Uint8*) data;
+                mappingSize = info.st_size;
+                header = (LImageCacheHeader*) mapping;
+                //Rows must hold width pixels and fit an int, SDL reads width * bytes per pixel of each one
+                bool valid = header->magic == IMAGE_CACHE_MAGIC && header->version == IMAGE_CACHE_VERSION && header->format == mFormat &&
+                    !SDL_ISPIXELFORMAT_FOURCC( mFormat ) && header->width > 0 && header->height > 0 &&
+                    header->pitch <= SDL_MAX_SINT32 && header->height <= SDL_MAX_SINT32 &&
+                    (Uint64) header->width * SDL_BYTESPERPIXEL( mFormat ) <= header->pitch &&
+                    sizeof( LImageCacheHeader ) + (Uint64) header->pitch * header->height == mappingSize;
+                if (!valid)
+                    header = NULL;
+            }
+        }
+    }
+
+    //Same size and modification time, the pixels are trusted without reading the source
+    bool usable = header != NULL && header->sourceSize == (Uint64) source.st_size &&
+        header->sourceSeconds == source.st_mtim.tv_sec && header->sourceNanoseconds == source.st_mtim.tv_nsec;
+    std::vector<Uint8> contents;
+    Uint64 hash = 0;
+    if (usable)
+        mHits++;
+    else if (!readFile( path, contents )) {
+        printf("Unable to read %s!\n", path.c_str());
+        if (mapping != NULL)
+            munmap( mapping, mappingSize );
+        if (file >= 0)
+            ::close( file );
+        return NULL;
+    }
+    else {
+        //Touched but unchanged, like after a checkout, only the timestamp needs updating
+        hash = hashContents( contents );
+        if (header != NULL && header->sourceSize == contents.size() && header->sourceHash == hash) {
+            LImageCacheHeader refreshed = *header;
+            refreshed.sourceSeconds = source.st_mtim.tv_sec;
+            refreshed.sourceNanoseconds = source.st_mtim.tv_nsec;
+            if (pwrite( file, &refreshed, sizeof( refreshed ), 0 ) != sizeof( refreshed ))
+                printf("Unable to refresh cache for %s!\n", path.c_str());
+            usable = true;
+            mRevalidated++;
+        }
+    }
+    if (file >= 0)
+        ::close( file );
+
+    SDL_Texture* texture = NULL;
+    if (usable) {
+        //Surface header over the mapped pixels, no decode and no conversion
+        SDL_Surface* cachedSurface = SDL_CreateRGBSurfaceWithFormatFrom( mapping + sizeof( LImageCacheHeader ), header->width, header->height,
+            SDL_BITSPERPIXEL( mFormat ), header->pitch, mFormat );
+        if (cachedSurface != NULL) {
+            texture = SDL_CreateTextureFromSurface( gRenderer, cachedSurface );
+            *width = cachedSurface->w;
+            *height = cachedSurface->h;
+            SDL_FreeSurface( cachedSurface );
+        }
+    }
+    else {
+        mMisses++;
+        SDL_Surface* convertedSurface = rebuild( path, contents, hash, &source );
+        if (convertedSurface != NULL) {
+            texture = SDL_CreateTextureFromSurface( gRenderer, convertedSurface );
+            *width = convertedSurface->w;
+            *height = convertedSurface->h;
+            SDL_FreeSurface( convertedSurface );
+        }
+    }
+    if (mapping != NULL)
+        munmap( mapping, mappingSize );
+
+    if (texture == NULL)
+        printf("Unable to create texture for %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+    return texture;
+}
+
+void LImageCache::remove( std::string path ) {
+    unlink( getCachePath( path ).c_str() );
+}
+
+void LImageCache::printStats() {
+    printf("Image cache (%s): %d hits, %d revalidated, %d rebuilt\n", SDL_GetPixelFormatName( mFormat ), mHits, mRevalidated, mMisses);
+}
+
+LImageCache gImageCache;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture, through the on-disk cache
+        bool loadFromFile( std::string path );
+
+        //Load image into texture, decoding and converting every time
+        bool loadFromFileUncached( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture scaled into a rect
+        void render( SDL_Rect* renderQuad );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    mTexture = gImageCache.loadTexture( path, &mWidth, &mHeight );
+    return mTexture != NULL;
+}
+
+bool LTexture::loadFromFileUncached( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = IMG_Load(path.c_str());
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image! SDL Error: %s\n", IMG_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( SDL_Rect* renderQuad ) {
+    SDL_RenderCopy( gRenderer, mTexture, NULL, renderQuad );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gTextures[ TOTAL_IMAGES ];
+
+//Picks the format cached pixels are stored in from the window's
+Uint32 getCacheFormat() {
+    //Color keyed images need alpha, so formats without it use their alpha twin
+    Uint32 format = SDL_GetWindowPixelFormat( gWindow );
+    if (format == SDL_PIXELFORMAT_RGB888)
+        format = SDL_PIXELFORMAT_ARGB8888;
+    else if (format == SDL_PIXELFORMAT_BGR888)
+        format = SDL_PIXELFORMAT_ABGR8888;
+    else if (!SDL_ISPIXELFORMAT_ALPHA( format ))
+        format = SDL_PIXELFORMAT_ARGB8888;
+    return format;
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    gImageCache.setFormat( getCacheFormat() );
+    for (int i = 0; i < TOTAL_IMAGES; i++) {
+        if (!gTextures[i].loadFromFile( gImageFiles[i] )) {
+            printf("Failed to load %s!\n", gImageFiles[i]);
+            success = false;
+        }
+    }
+    gImageCache.printStats();
+    return success;
+}
+
+//Loads every image once and returns ms taken
+double timeLoad( bool cached ) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    LTexture textures[ TOTAL_IMAGES ];
+    for (int i = 0; i < TOTAL_IMAGES; i++) {
+        if (cached)
+            textures[i].loadFromFile( gImageFiles[i] );
+        else
+            textures[i].loadFromFileUncached( gImageFiles[i] );
+    }
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void benchmark() {
+    gImageCache.setFormat( getCacheFormat() );
+
+    //First launch builds the cache, it pays for decoding and writing
+    for (int i = 0; i < TOTAL_IMAGES; i++)
+        gImageCache.remove( gImageFiles[i] );
+    double build = timeLoad( true );
+
+    double decode = 0, warm = 0;
+    for (int i = 0; i < BENCH_RUNS; i++) {
+        decode += timeLoad( false );
+        warm += timeLoad( true );
+    }
+
+    printf("%d images into %s\n", TOTAL_IMAGES, SDL_GetPixelFormatName( getCacheFormat() ));
+    printf("decode and convert  %10.3f ms\n", decode / BENCH_RUNS);
+    printf("cache build         %10.3f ms\n", build);
+    printf("warm cache          %10.3f ms\n", warm / BENCH_RUNS);
+    gImageCache.printStats();
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_IMAGES; i++)
+        gTextures[i].free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init( bool vsync ) {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface, benchmarks run unthrottled
+            Uint32 flags = SDL_RENDERER_ACCELERATED;
+            if (vsync)
+                flags |= SDL_RENDERER_PRESENTVSYNC;
+            gRenderer = SDL_CreateRenderer(gWindow, -1, flags);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize PNG loading
+                int imgFlags = IMG_INIT_PNG;
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    bool bench = argc > 1 && strcmp( args[1], "--bench" ) == 0;
+    if (!init( !bench )) {
+        printf("Failed to initialize!\n");
+    }
+    else if (bench) {
+        benchmark();
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                }
+                //Clear screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                //Every image in a 4x3 grid of thumbnails
+                for (int i = 0; i < TOTAL_IMAGES; i++) {
+                    SDL_Rect renderQuad = { ( i % 4 ) * SCREEN_WIDTH / 4 + 4, ( i / 4 ) * SCREEN_HEIGHT / 3 + 4, SCREEN_WIDTH / 4 - 8, SCREEN_HEIGHT / 3 - 8 };
+                    gTextures[i].render( &renderQuad );
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include "qoi.h"
+
+int main( int argc, char *args[] ) {
+    if (argc < 2) {
+        printf("Usage: %s <image>...\n", args[0]);
+        return 1;
+    }
+
+    if ( !( IMG_Init( IMG_INIT_PNG ) & IMG_INIT_PNG ) ) {
+        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        return 1;
+    }
+
+    //Each image is written next to where it is run from, with its extension swapped for .qoi
+    bool success = true;
+    for (int i = 1; i < argc; i++) {
+        std::string path = args[i];
+        std::string name = path.substr( path.find_last_of( '/' ) + 1 );
+        std::string output = name.substr( 0, name.find_last_of( '.' ) ) + ".qoi";
+
+        SDL_Surface* loadedSurface = IMG_Load( path.c_str() );
+        if (loadedSurface == NULL) {
+            printf("Unable to load %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+            success = false;
+            continue;
+        }
+
+        //Pixels are stored as decoded, loaders apply color keys as they do for PNG
+        std::vector<Uint8> encoded;
+        if (!encodeQOI( loadedSurface, encoded )) {
+            printf("Unable to encode %s! SDL Error: %s\n", path.c_str(), SDL_GetError());
+            success = false;
+        }
+        else {
+            FILE* file = fopen( output.c_str(), "wb" );
+            bool written = file != NULL && fwrite( encoded.data(), 1, encoded.size(), file ) == encoded.size();
+            if (file != NULL && fclose( file ) != 0)
+                written = false;
+            if (!written) {
+                printf("Unable to write %s!\n", output.c_str());
+                success = false;
+            }
+            else
+                printf("%s: %dx%d, %d bytes\n", output.c_str(), loadedSurface->w, loadedSurface->h, (int) encoded.size());
+        }
+        SDL_FreeSurface( loadedSurface );
+    }
+
+    IMG_Quit();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <string.h>
+#include <glob.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "qoi.h"
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_IMAGES = 11;
+const char* gImageNames[ TOTAL_IMAGES ] = { "loaded", "texture", "dots", "foo", "background", "colors",
+    "button", "arrow", "fadein", "fadeout", "viewport" };
+
+//Each decoder runs at least this long per asset so small images still time well
+const double BENCH_MIN_MS = 50.0;
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Load image into texture, .qoi files skip SDL_image
+        bool loadFromFile( std::string path );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture scaled into a rect
+        void render( SDL_Rect* renderQuad );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+//Checks the end of a path
+bool hasExtension( std::string path, std::string extension ) {
+    return path.size() >= extension.size() && path.compare( path.size() - extension.size(), extension.size(), extension ) == 0;
+}
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    //Delete the previous texture
+    free();
+    SDL_Texture* newTexture = NULL;
+    //Surface to store the image
+    SDL_Surface* loadedSurface = hasExtension( path, ".qoi" ) ? loadQOI( path ) : IMG_Load( path.c_str() );
+    if ( loadedSurface == NULL )
+        printf( "Unable to load image %s! SDL Error: %s\n", path.c_str(), SDL_GetError() );
+
+    else {
+        //Create texture from surface pixels
+
+        SDL_SetColorKey(loadedSurface, SDL_TRUE, SDL_MapRGB( loadedSurface->format, 0, 0xFF, 0xFF ));
+        newTexture = SDL_CreateTextureFromSurface(gRenderer, loadedSurface);
+        if (newTexture == NULL)
+            printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+
+        else {
+            //Store image dimesions
+            mWidth = loadedSurface->w;
+            mHeight = loadedSurface->h;
+        }
+
+        //get rid of old surface
+        SDL_FreeSurface(loadedSurface);
+    }
+    mTexture = newTexture;
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( SDL_Rect* renderQuad ) {
+    SDL_RenderCopy( gRenderer, mTexture, NULL, renderQuad );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LTexture gPNGTextures[ TOTAL_IMAGES ];
+LTexture gQOITextures[ TOTAL_IMAGES ];
+
+//Reads a whole file, false if it can't be read
+bool readFile( std::string path, std::vector<Uint8>& contents ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL)
+        return false;
+
+    Sint64 size = SDL_RWsize( file );
+    bool success = size >= 0;
+    if (success) {
+        contents.resize( size );
+        success = size == 0 || SDL_RWread( file, contents.data(), size, 1 ) == 1;
+    }
+    SDL_RWclose( file );
+    return success;
+}
+
+//64-bit FNV-1a over the file bytes, length folded in to separate prefixes
+Uint64 hashContents( std::vector<Uint8>& contents ) {
+    Uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < contents.size(); i++) {
+        hash ^= contents[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ contents.size();
+}
+
+//Decodes a PNG from memory repeatedly, returns ms per decode
+double timePNG( std::vector<Uint8>& contents ) {
+    int runs = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    double elapsed = 0;
+    while (elapsed < BENCH_MIN_MS || runs < 3) {
+        SDL_FreeSurface( IMG_Load_RW( SDL_RWFromConstMem( contents.data(), contents.size() ), 1 ) );
+        runs++;
+        elapsed = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+    return elapsed / runs;
+}
+
+//Decodes a QOI from memory repeatedly, returns ms per decode
+double timeQOI( std::vector<Uint8>& encoded ) {
+    int runs = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    double elapsed = 0;
+    while (elapsed < BENCH_MIN_MS || runs < 3) {
+        SDL_FreeSurface( decodeQOI( encoded.data(), encoded.size() ) );
+        runs++;
+        elapsed = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+    return elapsed / runs;
+}
+
+//Compares sizes and decode speed for every distinct PNG in the lessons
+void benchmark() {
+    glob_t found;
+    if (glob( "../*/*.png", 0, NULL, &found ) != 0) {
+        printf("No PNG assets found next to this lesson!\n");
+        return;
+    }
+
+    printf("%-28s %9s %9s %11s %11s\n", "asset", "PNG KB", "QOI KB", "PNG MPix/s", "QOI MPix/s");
+    std::map<Uint64, bool> seen;
+    double pngBytes = 0, qoiBytes = 0, pixels = 0, pngMs = 0, qoiMs = 0;
+    for (size_t i = 0; i < found.gl_pathc; i++) {
+        //Lessons copy their assets, each distinct file is measured once
+        std::vector<Uint8> contents;
+        if (!readFile( found.gl_pathv[i], contents ) || seen.count( hashContents( contents ) ))
+            continue;
+        seen[ hashContents( contents ) ] = true;
+
+        SDL_Surface* decoded = IMG_Load_RW( SDL_RWFromConstMem( contents.data(), contents.size() ), 1 );
+        std::vector<Uint8> encoded;
+        if (decoded == NULL || !encodeQOI( decoded, encoded )) {
+            printf("Unable to convert %s!\n", found.gl_pathv[i]);
+            SDL_FreeSurface( decoded );
+            continue;
+        }
+        double megapixels = decoded->w * decoded->h / 1000000.0;
+        SDL_FreeSurface( decoded );
+
+        double png = timePNG( contents );
+        double qoi = timeQOI( encoded );
+        printf("%-28s %9.1f %9.1f %11.1f %11.1f\n", found.gl_pathv[i] + 3, contents.size() / 1024.0, encoded.size() / 1024.0, megapixels * 1000 / png, megapixels * 1000 / qoi);
+        pngBytes += contents.size();
+        qoiBytes += encoded.size();
+        pixels += megapixels;
+        pngMs += png;
+        qoiMs += qoi;
+    }
+    globfree( &found );
+
+    printf("%-28s %9.1f %9.1f %11.1f %11.1f\n", "all distinct assets", pngBytes / 1024, qoiBytes / 1024, pixels * 1000 / pngMs, pixels * 1000 / qoiMs);
+}
+
+bool loadMedia() {
+    bool success = true;
+
+    for (int i = 0; i < TOTAL_IMAGES; i++) {
+        std::string name = gImageNames[i];
+        if (!gPNGTextures[i].loadFromFile( name + ".png" ))
+            success = false;
+        if (!gQOITextures[i].loadFromFile( name + ".qoi" )) {
+            printf("Failed to load %s.qoi, run make qoi first!\n", name.c_str());
+            success = false;
+        }
+    }
+    return success;
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_IMAGES; i++) {
+        gPNGTextures[i].free();
+        gQOITextures[i].free();
+    }
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //Initialize PNG loading
+                int imgFlags = IMG_INIT_PNG;
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    //Decoders are timed without a window, only SDL_image needs starting
+    if (argc > 1 && strcmp( args[1], "--bench" ) == 0) {
+        if ( !( IMG_Init( IMG_INIT_PNG ) & IMG_INIT_PNG ) )
+            printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        else
+            benchmark();
+        IMG_Quit();
+        return 0;
+    }
+
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            bool showQOI = true;
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Space flips between the two decodes, they should look the same
+                    else if ( e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE ) {
+                        showQOI = !showQOI;
+                        printf("Showing %s\n", showQOI ? "QOI" : "PNG");
+                    }
+                }
+                //Clear screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                //Every image in a 4x3 grid of thumbnails
+                for (int i = 0; i < TOTAL_IMAGES; i++) {
+                    SDL_Rect renderQuad = { ( i % 4 ) * SCREEN_WIDTH / 4 + 4, ( i / 4 ) * SCREEN_HEIGHT / 3 + 4, SCREEN_WIDTH / 4 - 8, SCREEN_HEIGHT / 3 - 8 };
+                    ( showQOI ? gQOITextures : gPNGTextures )[i].render( &renderQuad );
+                }
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+#include "qoi.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Chunk tags, the 2-bit ones live in the top bits of the first byte
+const Uint8 QOI_OP_INDEX = 0x00;
+const Uint8 QOI_OP_DIFF = 0x40;
+const Uint8 QOI_OP_LUMA = 0x80;
+const Uint8 QOI_OP_RUN = 0xC0;
+const Uint8 QOI_OP_RGB = 0xFE;
+const Uint8 QOI_OP_RGBA = 0xFF;
+const Uint8 QOI_MASK = 0xC0;
+const Uint8 QOI_END_MARKER[ QOI_END_SIZE ] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+//Slot of a color in the 64 entry table of recently seen pixels
+inline int hashPixel( Uint8 r, Uint8 g, Uint8 b, Uint8 a ) {
+    return ( r * 3 + g * 5 + b * 7 + a * 11 ) & 63;
+}
+
+inline Uint32 readBE32( const Uint8* data ) {
+    return ( (Uint32) data[0] << 24 ) | ( data[1] << 16 ) | ( data[2] << 8 ) | data[3];
+}
+
+inline void writeBE32( std::vector<Uint8>& output, Uint32 value ) {
+    output.push_back( value >> 24 );
+    output.push_back( value >> 16 );
+    output.push_back( value >> 8 );
+    output.push_back( value );
+}
+
+//Writes a run of one pixel, runs are the only part of QOI that is not serial
+inline void fillPixels( Uint32* pixels, Uint32 pixel, int count ) {
+#if defined(__SSE2__)
+    __m128i repeated = _mm_set1_epi32( pixel );
+    for (; count >= 4; count -= 4, pixels += 4)
+        _mm_storeu_si128( (__m128i*) pixels, repeated );
+#endif
+    for (; count > 0; count--)
+        *pixels++ = pixel;
+}
+
+SDL_Surface* decodeQOI( const Uint8* data, size_t size ) {
+    if (size < (size_t) QOI_HEADER_SIZE + QOI_END_SIZE || readBE32( data ) != QOI_MAGIC) {
+        SDL_SetError( "Not a QOI image" );
+        return NULL;
+    }
+    Uint32 width = readBE32( data + 4 );
+    Uint32 height = readBE32( data + 8 );
+    Uint8 channels = data[12];
+    Uint8 colorspace = data[13];
+    if (width == 0 || height == 0 || channels < 3 || channels > 4 || colorspace > 1 || height >= QOI_MAX_PIXELS / width) {
+        SDL_SetError( "Bad QOI header" );
+        return NULL;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat( 0, width, height, 32, SDL_PIXELFORMAT_ARGB8888 );
+    if (surface == NULL)
+        return NULL;
+
+    //32-bit rows are never padded, so the image is one run of pixels
+    Uint32* pixels = (Uint32*) surface->pixels;
+    Uint32 count = width * height;
+    Uint32 index[ 64 ];
+    memset( index, 0, sizeof( index ) );
+    Uint8 r = 0, g = 0, b = 0, a = 0xFF;
+    size_t p = QOI_HEADER_SIZE;
+    size_t end = size - QOI_END_SIZE;
+    Uint32 i = 0;
+    while (i < count) {
+        //Truncated data keeps repeating the last pixel, as the reference decoder does
+        if (p >= end) {
+            fillPixels( pixels + i, ( (Uint32) a << 24 ) | ( r << 16 ) | ( g << 8 ) | b, count - i );
+            break;
+        }
+
+        Uint8 b1 = data[ p++ ];
+        int run = 1;
+        if (b1 == QOI_OP_RGB && p + 3 <= end) {
+            r = data[p];
+            g = data[ p + 1 ];
+            b = data[ p + 2 ];
+            p += 3;
+        }
+        else if (b1 == QOI_OP_RGBA && p + 4 <= end) {
+            r = data[p];
+            g = data[ p + 1 ];
+            b = data[ p + 2 ];
+            a = data[ p + 3 ];
+            p += 4;
+        }
+        else if (( b1 & QOI_MASK ) == QOI_OP_INDEX) {
+            Uint32 pixel = index[b1];
+            a = pixel >> 24;
+            r = pixel >> 16;
+            g = pixel >> 8;
+            b = pixel;
+        }
+        else if (( b1 & QOI_MASK ) == QOI_OP_DIFF) {
+            r += ( ( b1 >> 4 ) & 0x03 ) - 2;
+            g += ( ( b1 >> 2 ) & 0x03 ) - 2;
+            b += ( b1 & 0x03 ) - 2;
+        }
+        else if (( b1 & QOI_MASK ) == QOI_OP_LUMA && p < end) {
+            Uint8 b2 = data[ p++ ];
+            int greenDiff = ( b1 & 0x3F ) - 32;
+            r += greenDiff - 8 + ( ( b2 >> 4 ) & 0x0F );
+            g += greenDiff;
+            b += greenDiff - 8 + ( b2 & 0x0F );
+        }
+        else if (( b1 & QOI_MASK ) == QOI_OP_RUN && b1 != QOI_OP_RGB && b1 != QOI_OP_RGBA)
+            run = ( b1 & 0x3F ) + 1;
+        else {
+            //A multi-byte chunk cut off by the end marker
+            p = end;
+            continue;
+        }
+
+        Uint32 pixel = ( (Uint32) a << 24 ) | ( r << 16 ) | ( g << 8 ) | b;
+        index[ hashPixel( r, g, b, a ) ] = pixel;
+        if (run > (int) ( count - i ))
+            run = count - i;
+        if (run == 1)
+            pixels[i] = pixel;
+        else
+            fillPixels( pixels + i, pixel, run );
+        i += run;
+    }
+    return surface;
+}
+
+SDL_Surface* loadQOI( std::string path ) {
+    SDL_RWops* file = SDL_RWFromFile( path.c_str(), "rb" );
+    if (file == NULL)
+        return NULL;
+
+    std::vector<Uint8> contents;
+    Sint64 size = SDL_RWsize( file );
+    bool success = size > 0;
+    if (success) {
+        contents.resize( size );
+        success = SDL_RWread( file, contents.data(), size, 1 ) == 1;
+    }
+    SDL_RWclose( file );
+    if (!success) {
+        SDL_SetError( "Unable to read %s", path.c_str() );
+        return NULL;
+    }
+    return decodeQOI( contents.data(), contents.size() );
+}
+
+bool encodeQOI( SDL_Surface* surface, std::vector<Uint8>& output ) {
+    //Encode from one known layout whatever the source format
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat( surface, SDL_PIXELFORMAT_ARGB8888, 0 );
+    if (converted == NULL)
+        return false;
+
+    bool opaque = true;
+    for (int y = 0; y < converted->h && opaque; y++) {
+        Uint32* row = (Uint32*) ( (Uint8*) converted->pixels + y * converted->pitch );
+        for (int x = 0; x < converted->w && opaque; x++)
+            opaque = ( row[x] >> 24 ) == 0xFF;
+    }
+
+    output.clear();
+    output.reserve( converted->w * converted->h + QOI_HEADER_SIZE + QOI_END_SIZE );
+    writeBE32( output, QOI_MAGIC );
+    writeBE32( output, converted->w );
+    writeBE32( output, converted->h );
+    output.push_back( opaque ? 3 : 4 );
+    output.push_back( 0 );
+
+    Uint32 index[ 64 ];
+    memset( index, 0, sizeof( index ) );
+    Uint32 previous = 0xFF000000;
+    int run = 0;
+    int last = converted->w * converted->h - 1;
+    for (int i = 0; i <= last; i++) {
+        Uint32 pixel = ( (Uint32*) ( (Uint8*) converted->pixels + ( i / converted->w ) * converted->pitch ) )[ i % converted->w ];
+        if (pixel == previous) {
+            run++;
+            if (run == 62 || i == last) {
+                output.push_back( QOI_OP_RUN | ( run - 1 ) );
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            output.push_back( QOI_OP_RUN | ( run - 1 ) );
+            run = 0;
+        }
+
+        Uint8 a = pixel >> 24, r = pixel >> 16, g = pixel >> 8, b = pixel;
+        int slot = hashPixel( r, g, b, a );
+        if (index[slot] == pixel)
+            output.push_back( QOI_OP_INDEX | slot );
+        else {
+            index[slot] = pixel;
+            if (a == ( previous >> 24 )) {
+                //Differences wrap around like the decoder's byte arithmetic
+                Sint8 redDiff = (Sint8) ( r - (Uint8) ( previous >> 16 ) );
+                Sint8 greenDiff = (Sint8) ( g - (Uint8) ( previous >> 8 ) );
+                Sint8 blueDiff = (Sint8) ( b - (Uint8) previous );
+                Sint8 redFromGreen = redDiff - greenDiff;
+                Sint8 blueFromGreen = blueDiff - greenDiff;
+                if (redDiff >= -2 && redDiff <= 1 && greenDiff >= -2 && greenDiff <= 1 && blueDiff >= -2 && blueDiff <= 1)
+                    output.push_back( QOI_OP_DIFF | ( ( redDiff + 2 ) << 4 ) | ( ( greenDiff + 2 ) << 2 ) | ( blueDiff + 2 ) );
+                else if (greenDiff >= -32 && greenDiff <= 31 && redFromGreen >= -8 && redFromGreen <= 7 && blueFromGreen >= -8 && blueFromGreen <= 7) {
+                    output.push_back( QOI_OP_LUMA | ( greenDiff + 32 ) );
+                    output.push_back( ( ( redFromGreen + 8 ) << 4 ) | ( blueFromGreen + 8 ) );
+                }
+                else {
+                    output.push_back( QOI_OP_RGB );
+                    output.push_back( r );
+                    output.push_back( g );
+                    output.push_back( b );
+                }
+            }
+            else {
+                output.push_back( QOI_OP_RGBA );
+                output.push_back( r );
+                output.push_back( g );
+                output.push_back( b );
+                output.push_back( a );
+            }
+        }
+        previous = pixel;
+    }
+    output.insert( output.end(), QOI_END_MARKER, QOI_END_MARKER + QOI_END_SIZE );
+    SDL_FreeSurface( converted );
+    return true;
+}
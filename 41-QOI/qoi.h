@@ -0,0 +1,25 @@
+#ifndef QOI_H
+#define QOI_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+//QOI layout: 14 byte header with big endian dimensions, chunks, then QOI_END_MARKER
+const Uint32 QOI_MAGIC = 0x716F6966; //"qoif"
+const int QOI_HEADER_SIZE = 14;
+const int QOI_END_SIZE = 8;
+
+//Largest image the decoder accepts, guards the size multiply
+const Uint32 QOI_MAX_PIXELS = 400000000;
+
+//Decodes a QOI image into a new ARGB8888 surface, NULL if the data is not valid QOI
+SDL_Surface* decodeQOI( const Uint8* data, size_t size );
+
+//Reads and decodes a QOI file
+SDL_Surface* loadQOI( std::string path );
+
+//Encodes any surface as QOI, alpha is only declared when some pixel is not opaque
+bool encodeQOI( SDL_Surface* surface, std::vector<Uint8>& output );
+
+#endif
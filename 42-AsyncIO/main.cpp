@@ -0,0 +1,799 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+#include <vector>
+
+//io_uring is driven through raw syscalls so the lesson does not need liburing
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define HAVE_IO_URING 1
+#endif
+#endif
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 480;
+const int TOTAL_IMAGES = 7;
+const char* gImageFiles[ TOTAL_IMAGES ] = { "images/press.bmp", "images/up.bmp", "images/down.bmp",
+    "images/left.bmp", "images/right.bmp", "texture.png", "dots.png" };
+const char* FONT_FILE = "lazy.ttf";
+const int FONT_SIZE = 20;
+
+//Threads reading files when io_uring is unavailable, the caller is one of them
+const int LOADER_THREADS = 4;
+
+//Largest number of reads in flight on the ring
+const unsigned URING_ENTRIES = 32;
+
+//Each benchmark figure is the mean of this many loads
+const int BENCH_RUNS = 5;
+
+enum LoadPath {
+    LOAD_SEQUENTIAL,
+    LOAD_THREADS,
+    LOAD_URING,
+    LOAD_TOTAL
+};
+
+SDL_Window* gWindow = NULL;
+SDL_Renderer* gRenderer = NULL;
+TTF_Font* gFont = NULL;
+
+#if defined(HAVE_IO_URING)
+//Submission and completion rings shared with the kernel
+class LUring {
+    public:
+        //Initializes internal variables
+        LUring();
+
+        //Closes the ring
+        ~LUring();
+
+        //Creates a ring with room for at least the given number of requests
+        bool init( unsigned entries );
+
+        //Unmaps rings and closes the ring
+        void free();
+
+        //Gets a cleared submission entry, NULL when the ring is full
+        io_uring_sqe* getSqe();
+
+        //Submits queued entries and waits for at least one completion, negative errno on failure
+        int submitAndWait();
+
+        //Pops the oldest completion, false when there is none
+        bool popCqe( io_uring_cqe* cqe );
+
+    private:
+        int mRing;
+
+        //Mappings of the three shared regions
+        void* mSqRing;
+        size_t mSqRingSize;
+        void* mCqRing;
+        size_t mCqRingSize;
+        io_uring_sqe* mSqes;
+        size_t mSqesSize;
+
+        //Fields inside the mappings, heads and tails are shared with the kernel
+        unsigned* mSqHead;
+        unsigned* mSqTail;
+        unsigned mSqMask;
+        unsigned mSqEntries;
+        unsigned* mCqHead;
+        unsigned* mCqTail;
+        unsigned mCqMask;
+        io_uring_cqe* mCqes;
+
+        //Local tail, published to the kernel on submit
+        unsigned mTail;
+        unsigned mUnsubmitted;
+};
+
+LUring::LUring() {
+    mRing = -1;
+    mSqRing = MAP_FAILED;
+    mSqRingSize = 0;
+    mCqRing = MAP_FAILED;
+    mCqRingSize = 0;
+    mSqes = (io_uring_sqe*) MAP_FAILED;
+    mSqesSize = 0;
+    mSqHead = NULL;
+    mSqTail = NULL;
+    mSqMask = 0;
+    mSqEntries = 0;
+    mCqHead = NULL;
+    mCqTail = NULL;
+    mCqMask = 0;
+    mCqes = NULL;
+    mTail = 0;
+    mUnsubmitted = 0;
+}
+
+LUring::~LUring() {
+    free();
+}
+
+bool LUring::init( unsigned entries ) {
+    free();
+    io_uring_params params;
+    memset( &params, 0, sizeof( params ) );
+    mRing = syscall( __NR_io_uring_setup, entries, &params );
+    if (mRing < 0) {
+        //Old kernels and seccomp filtered containers refuse, callers fall back
+        mRing = -1;
+        return false;
+    }
+
+    //Map each region on its own, this works whether or not the kernel shares the ring mappings
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof( unsigned );
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof( io_uring_cqe );
+    mSqesSize = params.sq_entries * sizeof( io_uring_sqe );
+    mSqRing = mmap( NULL, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQ_RING );
+    mCqRing = mmap( NULL, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_CQ_RING );
+    mSqes = (io_uring_sqe*) mmap( NULL, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, IORING_OFF_SQES );
+    if (mSqRing == MAP_FAILED || mCqRing == MAP_FAILED || mSqes == MAP_FAILED) {
+        free();
+        return false;
+    }
+
+    Uint8* sq = (Uint8*) mSqRing;
+    mSqHead = (unsigned*) ( sq + params.sq_off.head );
+    mSqTail = (unsigned*) ( sq + params.sq_off.tail );
+    mSqMask = *(unsigned*) ( sq + params.sq_off.ring_mask );
+    mSqEntries = params.sq_entries;
+    Uint8* cq = (Uint8*) mCqRing;
+    mCqHead = (unsigned*) ( cq + params.cq_off.head );
+    mCqTail = (unsigned*) ( cq + params.cq_off.tail );
+    mCqMask = *(unsigned*) ( cq + params.cq_off.ring_mask );
+    mCqes = (io_uring_cqe*) ( cq + params.cq_off.cqes );
+
+    //Slot i of the indirection array always names entry i, so it is filled once
+    unsigned* array = (unsigned*) ( sq + params.sq_off.array );
+    for (unsigned i = 0; i < mSqEntries; i++)
+        array[i] = i;
+    mTail = *mSqTail;
+    mUnsubmitted = 0;
+    return true;
+}
+
+void LUring::free() {
+    if (mSqes != MAP_FAILED)
+        munmap( mSqes, mSqesSize );
+    if (mCqRing != MAP_FAILED)
+        munmap( mCqRing, mCqRingSize );
+    if (mSqRing != MAP_FAILED)
+        munmap( mSqRing, mSqRingSize );
+    mSqes = (io_uring_sqe*) MAP_FAILED;
+    mCqRing = MAP_FAILED;
+    mSqRing = MAP_FAILED;
+    if (mRing >= 0) {
+        ::close( mRing );
+        mRing = -1;
+    }
+}
+
+io_uring_sqe* LUring::getSqe() {
+    //The kernel advances the head as it consumes entries
+    if (mTail - __atomic_load_n( mSqHead, __ATOMIC_ACQUIRE ) >= mSqEntries)
+        return NULL;
+    io_uring_sqe* sqe = &mSqes[ mTail & mSqMask ];
+    memset( sqe, 0, sizeof( *sqe ) );
+    mTail++;
+    mUnsubmitted++;
+    return sqe;
+}
+
+int LUring::submitAndWait() {
+    //Entries must be fully written before the kernel sees the new tail
+    __atomic_store_n( mSqTail, mTail, __ATOMIC_RELEASE );
+    while (true) {
+        int submitted = syscall( __NR_io_uring_enter, mRing, mUnsubmitted, 1, IORING_ENTER_GETEVENTS, NULL, 0 );
+        if (submitted >= 0) {
+            mUnsubmitted -= submitted;
+            return submitted;
+        }
+        if (errno != EINTR)
+            return -errno;
+    }
+}
+
+bool LUring::popCqe( io_uring_cqe* cqe ) {
+    unsigned head = *mCqHead;
+    if (head == __atomic_load_n( mCqTail, __ATOMIC_ACQUIRE ))
+        return false;
+    *cqe = mCqes[ head & mCqMask ];
+
+    //Hand the slot back once it has been copied out
+    __atomic_store_n( mCqHead, head + 1, __ATOMIC_RELEASE );
+    return true;
+}
+#endif
+
+//One file read whole into memory
+struct LFileRead {
+    std::string path;
+    int file;
+    Uint8* data;
+    size_t size;
+
+    //Bytes read so far, reads can come back short
+    size_t done;
+    bool failed;
+
+    //Target of the read submitted for this file, must outlive the submission
+    iovec target;
+};
+
+//Reads a set of files all at once and keeps the bytes for decoders
+class LAssetLoader {
+    public:
+        //Initializes internal variables
+        LAssetLoader();
+
+        //Frees buffers
+        ~LAssetLoader();
+
+        //Queues a file for the next readAll, returns its index
+        int add( std::string path );
+
+        //Reads every queued file, on io_uring if allowed and available, false if any failed
+        bool readAll( bool allowUring );
+
+        //Wraps a read file for a decoder, the loader keeps the bytes so fonts can stream from them
+        SDL_RWops* getRW( int index );
+
+        //Gets what did the reading in the last readAll
+        const char* getBackend();
+
+        //Frees buffers, streams from getRW must be closed first
+        void free();
+
+    private:
+        //Opens and sizes every file and hints the kernel to start reading them
+        void openAll();
+
+        //Closes file descriptors once reads are done
+        void closeAll();
+
+#if defined(HAVE_IO_URING)
+        //Submits every read on one ring, false if the ring could not be made or failed,
+        //reads it did not finish are left for the thread pool
+        bool readWithUring();
+#endif
+
+        //Reads files on a few threads with blocking pread
+        void readWithThreads();
+
+        //Reader thread entry
+        static int SDLCALL readerThread( void* data );
+
+        //Claims and reads files until none are left
+        void readFiles();
+
+        std::vector<LFileRead> mReads;
+        SDL_atomic_t mNextRead;
+        const char* mBackend;
+};
+
+LAssetLoader::LAssetLoader() {
+    SDL_AtomicSet( &mNextRead, 0 );
+    mBackend = "none";
+}
+
+LAssetLoader::~LAssetLoader() {
+    free();
+}
+
+int LAssetLoader::add( std::string path ) {
+    LFileRead read;
+    read.path = path;
+    read.file = -1;
+    read.data = NULL;
+    read.size = 0;
+    read.done = 0;
+    read.failed = false;
+    mReads.push_back( read );
+    return mReads.size() - 1;
+}
+
+bool LAssetLoader::readAll( bool allowUring ) {
+    openAll();
+
+    bool ringed = false;
+#if defined(HAVE_IO_URING)
+    if (allowUring)
+        ringed = readWithUring();
+#endif
+    if (!ringed)
+        readWithThreads();
+    mBackend = ringed ? "io_uring" : ( allowUring ? "thread pool, io_uring unavailable" : "thread pool" );
+    closeAll();
+
+    bool success = true;
+    for (size_t i = 0; i < mReads.size(); i++) {
+        if (mReads[i].failed || mReads[i].done != mReads[i].size) {
+            printf("Unable to read %s!\n", mReads[i].path.c_str());
+            mReads[i].failed = true;
+            success = false;
+        }
+    }
+    return success;
+}
+
+SDL_RWops* LAssetLoader::getRW( int index ) {
+    if (index < 0 || index >= (int) mReads.size() || mReads[ index ].failed) {
+        SDL_SetError( "Asset was not read" );
+        return NULL;
+    }
+    return SDL_RWFromConstMem( mReads[ index ].data, mReads[ index ].size );
+}
+
+const char* LAssetLoader::getBackend() {
+    return mBackend;
+}
+
+void LAssetLoader::free() {
+    closeAll();
+    for (size_t i = 0; i < mReads.size(); i++)
+        ::free( mReads[i].data );
+    mReads.clear();
+    mBackend = "none";
+}
+
+void LAssetLoader::openAll() {
+    for (size_t i = 0; i < mReads.size(); i++) {
+        LFileRead& read = mReads[i];
+        struct stat info;
+        read.file = ::open( read.path.c_str(), O_RDONLY | O_CLOEXEC );
+        if (read.file < 0 || fstat( read.file, &info ) != 0 || info.st_size <= 0) {
+            read.failed = true;
+            continue;
+        }
+        read.size = info.st_size;
+        read.data = (Uint8*) malloc( read.size );
+        if (read.data == NULL) {
+            read.failed = true;
+            continue;
+        }
+
+        //Readahead for every file starts now, before any read is waited on
+        posix_fadvise( read.file, 0, 0, POSIX_FADV_WILLNEED );
+    }
+}
+
+void LAssetLoader::closeAll() {
+    for (size_t i = 0; i < mReads.size(); i++) {
+        if (mReads[i].file >= 0) {
+            ::close( mReads[i].file );
+            mReads[i].file = -1;
+        }
+    }
+}
+
+#if defined(HAVE_IO_URING)
+bool LAssetLoader::readWithUring() {
+    LUring ring;
+    if (!ring.init( URING_ENTRIES ))
+        return false;
+
+    //Reads waiting for a free entry, files read short are queued again for the rest
+    std::vector<int> waiting;
+    for (size_t i = 0; i < mReads.size(); i++) {
+        if (!mReads[i].failed)
+            waiting.push_back( i );
+    }
+
+    size_t next = 0;
+    int inFlight = 0;
+    bool ringFailed = false;
+    while (( !ringFailed && next < waiting.size() ) || inFlight > 0) {
+        io_uring_sqe* sqe;
+        while (!ringFailed && next < waiting.size() && ( sqe = ring.getSqe() ) != NULL) {
+            int index = waiting[ next++ ];
+            LFileRead& read = mReads[ index ];
+            read.target.iov_base = read.data + read.done;
+            read.target.iov_len = read.size - read.done;
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = read.file;
+            sqe->addr = (Uint64) (uintptr_t) &read.target;
+            sqe->len = 1;
+            sqe->off = read.done;
+            sqe->user_data = index;
+            inFlight++;
+        }
+
+        //A busy ring only needs completions reaped before submitting again
+        int submitted = ring.submitAndWait();
+        if (submitted < 0 && submitted != -EAGAIN && submitted != -EBUSY) {
+            //Reads still in flight land the same bytes the threads will read again
+            printf("io_uring_enter failed: %s\n", strerror( -submitted ));
+            return false;
+        }
+
+        io_uring_cqe cqe;
+        while (ring.popCqe( &cqe )) {
+            inFlight--;
+            LFileRead& read = mReads[ cqe.user_data ];
+            //A kernel without the opcode fails every read, the threads retry those instead
+            if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP)
+                ringFailed = true;
+            else if (cqe.res <= 0)
+                read.failed = true;
+            else {
+                read.done += cqe.res;
+                if (read.done < read.size)
+                    waiting.push_back( cqe.user_data );
+            }
+        }
+    }
+    if (ringFailed)
+        printf("io_uring cannot read these files, using the thread pool\n");
+    return !ringFailed;
+}
+#endif
+
+void LAssetLoader::readWithThreads() {
+    SDL_AtomicSet( &mNextRead, 0 );
+
+    //A thread that fails to start just leaves more files for the others
+    int extraThreads = SDL_min( (int) mReads.size(), LOADER_THREADS ) - 1;
+    std::vector<SDL_Thread*> threads;
+    for (int i = 0; i < extraThreads; i++)
+        threads.push_back( SDL_CreateThread( readerThread, "AssetReader", this ) );
+    readFiles();
+    for (size_t i = 0; i < threads.size(); i++) {
+        if (threads[i] != NULL)
+            SDL_WaitThread( threads[i], NULL );
+    }
+}
+
+int SDLCALL LAssetLoader::readerThread( void* data ) {
+    ( (LAssetLoader*) data )->readFiles();
+    return 0;
+}
+
+void LAssetLoader::readFiles() {
+    int index;
+    while (( index = SDL_AtomicAdd( &mNextRead, 1 ) ) < (int) mReads.size()) {
+        LFileRead& read = mReads[ index ];
+        while (!read.failed && read.done < read.size) {
+            ssize_t result = pread( read.file, read.data + read.done, read.size - read.done, read.done );
+            if (result < 0 && errno == EINTR)
+                continue;
+            if (result <= 0)
+                read.failed = true;
+            else
+                read.done += result;
+        }
+    }
+}
+
+class LTexture {
+    public:
+        //Constructor
+        LTexture();
+
+        //Destructor
+        ~LTexture();
+
+        //Decodes an image file, SDL_image opens and reads it itself
+        bool loadFromFile( std::string path );
+
+        //Decodes an image from a stream, the stream is closed
+        bool loadFromRW( SDL_RWops* stream );
+
+        //Creates image from font string
+        bool loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor );
+
+        //Dealocates texture
+        void free();
+
+        //Renders texture scaled into a rect
+        void render( SDL_Rect* renderQuad );
+
+        //Gets image dimensions
+        int getWidth();
+        int getHeight();
+
+    private:
+        //Creates the texture and frees the surface
+        bool loadFromSurface( SDL_Surface* loadedSurface );
+
+        //Hardware Texture
+        SDL_Texture* mTexture;
+
+        //Image Dimensions
+        int mWidth;
+        int mHeight;
+};
+
+LTexture::LTexture() {
+    mTexture = NULL;
+    mWidth = 0;
+    mHeight = 0;
+}
+
+LTexture::~LTexture() {
+    free();
+}
+
+bool LTexture::loadFromFile( std::string path ) {
+    return loadFromSurface( IMG_Load( path.c_str() ) );
+}
+
+bool LTexture::loadFromRW( SDL_RWops* stream ) {
+    return loadFromSurface( IMG_Load_RW( stream, 1 ) );
+}
+
+bool LTexture::loadFromRenderedText( TTF_Font* font, std::string textureText, SDL_Color textColor ) {
+    return loadFromSurface( TTF_RenderText_Blended( font, textureText.c_str(), textColor ) );
+}
+
+bool LTexture::loadFromSurface( SDL_Surface* loadedSurface ) {
+    //Delete the previous texture
+    free();
+    if ( loadedSurface == NULL ) {
+        printf( "Unable to load image! SDL Error: %s\n", SDL_GetError() );
+        return false;
+    }
+
+    //Create texture from surface pixels
+    mTexture = SDL_CreateTextureFromSurface( gRenderer, loadedSurface );
+    if (mTexture == NULL)
+        printf("Unable to create texture! SDL Error:%s\n", SDL_GetError());
+    else {
+        //Store image dimesions
+        mWidth = loadedSurface->w;
+        mHeight = loadedSurface->h;
+    }
+
+    //get rid of old surface
+    SDL_FreeSurface( loadedSurface );
+    return mTexture != NULL;
+}
+
+void LTexture::free() {
+    //Free texture if it exists
+    if (mTexture != NULL) {
+        SDL_DestroyTexture( mTexture );
+        mTexture = NULL;
+        mHeight = 0;
+        mWidth = 0;
+    }
+}
+
+void LTexture::render( SDL_Rect* renderQuad ) {
+    SDL_RenderCopy( gRenderer, mTexture, NULL, renderQuad );
+}
+
+int LTexture::getHeight() {
+    return mHeight;
+}
+
+int LTexture::getWidth() {
+    return mWidth;
+}
+
+LAssetLoader gLoader;
+LTexture gTextures[ TOTAL_IMAGES ];
+LTexture gStatusTexture;
+
+//Loads every image and the font, sequential lets each decoder open its own file one after another
+bool loadAssets( LoadPath path, LAssetLoader* loader, LTexture* textures, TTF_Font** font ) {
+    bool success = true;
+    if (path == LOAD_SEQUENTIAL) {
+        for (int i = 0; i < TOTAL_IMAGES; i++)
+            success = textures[i].loadFromFile( gImageFiles[i] ) && success;
+        *font = TTF_OpenFont( FONT_FILE, FONT_SIZE );
+    }
+    else {
+        //Every read is in flight before the first decode starts
+        for (int i = 0; i < TOTAL_IMAGES; i++)
+            loader->add( gImageFiles[i] );
+        int fontIndex = loader->add( FONT_FILE );
+        success = loader->readAll( path == LOAD_URING );
+
+        for (int i = 0; i < TOTAL_IMAGES; i++)
+            success = textures[i].loadFromRW( loader->getRW( i ) ) && success;
+        SDL_RWops* fontStream = loader->getRW( fontIndex );
+        *font = fontStream == NULL ? NULL : TTF_OpenFontRW( fontStream, 1, FONT_SIZE );
+    }
+
+    if (*font == NULL) {
+        printf("Failed to load font! SDL_ttf Error: %s\n", TTF_GetError());
+        success = false;
+    }
+    return success;
+}
+
+bool loadMedia() {
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool success = loadAssets( LOAD_URING, &gLoader, gTextures, &gFont );
+    double elapsed = ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    if (success) {
+        char status[ 64 ];
+        SDL_snprintf( status, sizeof( status ), "Loaded %d files in %.1f ms with %s", TOTAL_IMAGES + 1, elapsed, gLoader.getBackend() );
+        SDL_Color textColor = { 0, 0, 0, 0xFF };
+        success = gStatusTexture.loadFromRenderedText( gFont, status, textColor );
+    }
+    return success;
+}
+
+//Asks the kernel to drop cached pages of a file so the next read is cold
+void evictFromPageCache( std::string path ) {
+    int file = ::open( path.c_str(), O_RDONLY );
+    if (file >= 0) {
+        posix_fadvise( file, 0, 0, POSIX_FADV_DONTNEED );
+        ::close( file );
+    }
+}
+
+//Loads every asset the way loadMedia does and returns ms taken
+double timeLoad( LoadPath path, bool cold, std::string& backend ) {
+    if (cold) {
+        for (int i = 0; i < TOTAL_IMAGES; i++)
+            evictFromPageCache( gImageFiles[i] );
+        evictFromPageCache( FONT_FILE );
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    LAssetLoader loader;
+    LTexture textures[ TOTAL_IMAGES ];
+    TTF_Font* font = NULL;
+    loadAssets( path, &loader, textures, &font );
+    Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    //The font streams from the loader, so it is closed first
+    if (font != NULL)
+        TTF_CloseFont( font );
+    backend = path == LOAD_SEQUENTIAL ? "blocking reads" : loader.getBackend();
+    return elapsed * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void benchmark() {
+    const char* names[ LOAD_TOTAL ] = { "sequential", "batched, threads", "batched, io_uring" };
+
+    //Cold runs drop the page cache first, best effort without root
+    printf("%-18s %-15s %10s %10s\n", "path", "reads on", "cold ms", "warm ms");
+    for (int path = 0; path < LOAD_TOTAL; path++) {
+        std::string backend;
+        double cold = 0, warm = 0;
+        for (int run = 0; run < BENCH_RUNS; run++)
+            cold += timeLoad( (LoadPath) path, true, backend );
+        for (int run = 0; run < BENCH_RUNS; run++)
+            warm += timeLoad( (LoadPath) path, false, backend );
+        printf("%-18s %-15s %10.3f %10.3f\n", names[ path ], backend.c_str(), cold / BENCH_RUNS, warm / BENCH_RUNS);
+    }
+}
+
+void close() {
+    for (int i = 0; i < TOTAL_IMAGES; i++)
+        gTextures[i].free();
+    gStatusTexture.free();
+
+    //The font reads from the loader's buffer until it is closed
+    TTF_CloseFont( gFont );
+    gFont = NULL;
+    gLoader.free();
+
+    SDL_DestroyRenderer( gRenderer );
+    SDL_DestroyWindow( gWindow );
+    gWindow = NULL;
+    gRenderer = NULL;
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+bool init() {
+    bool success = true;
+    if ( SDL_Init( SDL_INIT_VIDEO ) < 0) {
+        printf("SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
+        success = false;
+    }
+    else {
+        gWindow = SDL_CreateWindow( "SDL_Tutorial", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
+        if (gWindow == NULL) {
+            printf("Window could not be created! SDL_Error: %s\n", SDL_GetError());
+            success = false;
+        }
+        else {
+            //Create renderer for window instead of surface
+            gRenderer = SDL_CreateRenderer(gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            if ( gRenderer == NULL ) {
+                printf("Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+                success = false;
+            }
+            else {
+                //Initialize renderer color
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+
+                //BMP is built in, PNG needs the flag
+                int imgFlags = IMG_INIT_PNG;
+                if ( !( IMG_Init( imgFlags ) & imgFlags ) ) {
+                    printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+                    success = false;
+                }
+
+                //Initialize SDL_ttf
+                if (TTF_Init() == -1) {
+                    printf("SDL_ttf could not be initialized! Error: %s\n", TTF_GetError());
+                    success = false;
+                }
+            }
+        }
+
+    }
+
+    return success;
+}
+
+int main( int argc, char *args[] ) {
+    if (!init()) {
+        printf("Failed to initialize!\n");
+    }
+    else {
+        if ( !loadMedia() ) {
+            printf("Failed to load Media!\n");
+        }
+        else if (argc > 1 && strcmp( args[1], "--bench" ) == 0) {
+            benchmark();
+        }
+        else {
+            bool quit = false;
+            SDL_Event e; //Variable to Store Event
+            int current = 0; //Key image shown, press.bmp until an arrow is pressed
+            //Main Loop
+            while (!quit) {
+                //Loop to get events from event queue
+                while (SDL_PollEvent( &e ) != 0) {
+                    //User requests quit
+                    if( e.type == SDL_QUIT ) {
+                        quit = true;
+                    }
+                    //Arrow keys pick the image as in the key press lesson
+                    else if (e.type == SDL_KEYDOWN) {
+                        switch (e.key.keysym.sym) {
+                            case SDLK_UP: current = 1; break;
+                            case SDLK_DOWN: current = 2; break;
+                            case SDLK_LEFT: current = 3; break;
+                            case SDLK_RIGHT: current = 4; break;
+                            default: current = 0; break;
+                        }
+                    }
+                }
+                //Clear screen
+                SDL_SetRenderDrawColor( gRenderer, 0xFF, 0xFF, 0xFF, 0xFF );
+                SDL_RenderClear( gRenderer );
+
+                //Key image behind, the two PNGs as thumbnails and the load time on top
+                SDL_Rect fullQuad = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+                gTextures[ current ].render( &fullQuad );
+                SDL_Rect textureQuad = { 8, SCREEN_HEIGHT - 128, 160, 120 };
+                gTextures[5].render( &textureQuad );
+                SDL_Rect dotsQuad = { SCREEN_WIDTH - 108, SCREEN_HEIGHT - 108, 100, 100 };
+                gTextures[6].render( &dotsQuad );
+                SDL_Rect statusQuad = { 8, 8, gStatusTexture.getWidth(), gStatusTexture.getHeight() };
+                gStatusTexture.render( &statusQuad );
+
+                //Update screen
+                SDL_RenderPresent( gRenderer );
+            }
+        }
+    }
+    close();
+    return 0;
+}